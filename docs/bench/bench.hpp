@@ -0,0 +1,155 @@
+// Copyright (c) 2017-2020 nyorain
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt
+
+// Minimal benchmarking harness in the spirit of bugged.hpp (the unit
+// test harness next door in docs/tests): header-only, no external
+// dependencies, one macro. Benchmarks iterate a State object, the
+// runner calibrates the iteration count, takes several samples and
+// reports the median ns per iteration as machine-readable JSON on
+// stdout, so runs can be diffed across commits.
+//
+// BENCH(dot) {
+//     auto a = nytl::Vec3f{1.f, 2.f, 3.f};
+//     for(auto _ : state) {
+//         bench::doNotOptimize(nytl::dot(a, a));
+//     }
+// }
+//
+// Define BENCH_NO_MAIN before including this header to write a
+// custom main function.
+
+#pragma once
+
+#include <chrono>
+#include <vector>
+#include <algorithm>
+#include <string>
+#include <cstdio>
+#include <cstdint>
+
+namespace bench {
+
+// Monotonic timestamp in nanoseconds.
+inline std::uint64_t now() {
+	auto tp = std::chrono::steady_clock::now().time_since_epoch();
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(tp).count();
+}
+
+// Forces the compiler to materialize the given value, preventing it
+// from optimizing away the computation that produced it.
+template<typename T>
+inline void doNotOptimize(T&& value) {
+	asm volatile("" : : "r,m"(value) : "memory");
+}
+
+// Forces all pending writes to memory.
+inline void clobber() {
+	asm volatile("" : : : "memory");
+}
+
+// Iteration handle passed to every benchmark body.
+// Supports range-based for over the calibrated iteration count.
+class State {
+public:
+	struct iterator {
+		std::uint64_t left;
+		bool operator!=(const iterator& rhs) const { return left != rhs.left; }
+		void operator++() { --left; }
+		std::uint64_t operator*() const { return left; }
+	};
+
+	explicit State(std::uint64_t iterations) : iterations_(iterations) {}
+	iterator begin() const { return {iterations_}; }
+	iterator end() const { return {0}; }
+	std::uint64_t iterations() const { return iterations_; }
+
+protected:
+	std::uint64_t iterations_;
+};
+
+using BenchFunc = void(*)(State&);
+
+class Registry {
+public:
+	// per-sample target duration and sample count of the runner
+	static constexpr auto minSampleNs = std::uint64_t {2'000'000};
+	static constexpr auto sampleCount = 9u;
+
+	struct Entry {
+		const char* name;
+		BenchFunc func;
+	};
+
+	static Registry& instance() {
+		static Registry registry;
+		return registry;
+	}
+
+	static int add(const char* name, BenchFunc func) {
+		instance().entries_.push_back({name, func});
+		return 0;
+	}
+
+	static std::uint64_t time(BenchFunc func, std::uint64_t iterations) {
+		State state(iterations);
+		auto start = now();
+		func(state);
+		return now() - start;
+	}
+
+	// Runs all registered benchmarks, printing one JSON document.
+	static int run() {
+		auto& entries = instance().entries_;
+		std::printf("{\"benchmarks\": [");
+
+		for(auto e = 0u; e < entries.size(); ++e) {
+			auto& entry = entries[e];
+
+			// calibrate: double the iteration count until one sample
+			// runs long enough to measure reliably
+			auto iterations = std::uint64_t {1};
+			while(time(entry.func, iterations) < minSampleNs &&
+					iterations < (std::uint64_t {1} << 40)) {
+				iterations *= 2;
+			}
+
+			std::vector<double> samples(sampleCount);
+			for(auto& sample : samples) {
+				sample = double(time(entry.func, iterations)) / iterations;
+			}
+
+			std::sort(samples.begin(), samples.end());
+			auto median = samples[samples.size() / 2];
+
+			std::printf("%s\n\t{\"name\": \"%s\", \"iterations\": %llu, "
+				"\"median_ns_per_iter\": %.4f, \"samples_ns_per_iter\": [",
+				e ? "," : "", entry.name,
+				static_cast<unsigned long long>(iterations), median);
+			for(auto s = 0u; s < samples.size(); ++s) {
+				std::printf("%s%.4f", s ? ", " : "", samples[s]);
+			}
+			std::printf("]}");
+		}
+
+		std::printf("\n]}\n");
+		return 0;
+	}
+
+protected:
+	std::vector<Entry> entries_;
+};
+
+} // namespace bench
+
+#define BENCH(name) \
+	static void nytl_bench_##name(::bench::State&); \
+	namespace { const auto nytl_bench_reg_##name = \
+		::bench::Registry::add(#name, nytl_bench_##name); } \
+	static void nytl_bench_##name(::bench::State& state)
+
+#ifndef BENCH_NO_MAIN
+int main() {
+	return ::bench::Registry::run();
+}
+#endif // BENCH_NO_MAIN
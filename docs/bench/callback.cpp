@@ -0,0 +1,40 @@
+#include "bench.hpp"
+#include <nytl/callback.hpp>
+#include <nytl/recursiveCallback.hpp>
+
+BENCH(call8) {
+	nytl::Callback<void(int)> cb;
+	auto sum = 0;
+	for(auto i = 0u; i < 8; ++i) {
+		cb.add([&](int v) { sum += v; });
+	}
+
+	for(auto _ : state) {
+		(void) _;
+		cb.call(1);
+		bench::doNotOptimize(sum);
+	}
+}
+
+BENCH(recursiveCall8) {
+	nytl::RecursiveCallback<void(int)> cb;
+	auto sum = 0;
+	for(auto i = 0u; i < 8; ++i) {
+		cb.add([&](int v) { sum += v; });
+	}
+
+	for(auto _ : state) {
+		(void) _;
+		cb.call(1);
+		bench::doNotOptimize(sum);
+	}
+}
+
+BENCH(addDisconnect) {
+	nytl::Callback<void()> cb;
+	for(auto _ : state) {
+		(void) _;
+		auto conn = cb.add([]{});
+		conn.disconnect();
+	}
+}
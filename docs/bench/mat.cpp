@@ -0,0 +1,36 @@
+#include "bench.hpp"
+#include <nytl/mat.hpp>
+#include <nytl/matOps.hpp>
+
+BENCH(mult4) {
+	auto a = nytl::identity<4, float>();
+	auto b = nytl::identity<4, float>();
+	a[0][3] = 2.f;
+	b[2][1] = 3.f;
+	for(auto _ : state) {
+		(void) _;
+		bench::doNotOptimize(a * b);
+	}
+}
+
+BENCH(luDecomp4) {
+	nytl::Mat4d m = nytl::identity<4, double>();
+	m[0][1] = 2.0;
+	m[1][3] = -1.0;
+	m[2][0] = 0.5;
+	for(auto _ : state) {
+		(void) _;
+		bench::doNotOptimize(nytl::luDecomp(m));
+	}
+}
+
+BENCH(inverse4) {
+	nytl::Mat4d m = nytl::identity<4, double>();
+	m[0][1] = 2.0;
+	m[1][3] = -1.0;
+	m[2][0] = 0.5;
+	for(auto _ : state) {
+		(void) _;
+		bench::doNotOptimize(nytl::inverse(m));
+	}
+}
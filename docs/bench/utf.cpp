@@ -0,0 +1,42 @@
+#include "bench.hpp"
+#include <nytl/utf.hpp>
+#include <string>
+
+namespace {
+
+// mixed ascii/multi-byte sample, repeated to a few KiB
+const std::string& sample() {
+	static const std::string str = [] {
+		std::string ret;
+		for(auto i = 0u; i < 128; ++i) {
+			ret += u8"the quick brown fox – schnelle bräune 狐 🦊 ";
+		}
+
+		return ret;
+	}();
+
+	return str;
+}
+
+} // anon namespace
+
+BENCH(charCount) {
+	for(auto _ : state) {
+		(void) _;
+		bench::doNotOptimize(nytl::charCount(sample()));
+	}
+}
+
+BENCH(validate) {
+	for(auto _ : state) {
+		(void) _;
+		bench::doNotOptimize(nytl::validUtf8(sample()));
+	}
+}
+
+BENCH(toUtf16) {
+	for(auto _ : state) {
+		(void) _;
+		bench::doNotOptimize(nytl::toUtf16(sample()));
+	}
+}
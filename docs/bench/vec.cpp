@@ -0,0 +1,43 @@
+#include "bench.hpp"
+#include <nytl/vec.hpp>
+#include <nytl/vecOps.hpp>
+#include <vector>
+
+BENCH(dot3f) {
+	nytl::Vec3f a {1.f, 2.f, 3.f};
+	nytl::Vec3f b {4.f, 5.f, 6.f};
+	for(auto _ : state) {
+		(void) _;
+		bench::doNotOptimize(nytl::dot(a, b));
+	}
+}
+
+BENCH(length4f) {
+	nytl::Vec4f a {1.f, 2.f, 3.f, 4.f};
+	for(auto _ : state) {
+		(void) _;
+		bench::doNotOptimize(nytl::length(a));
+	}
+}
+
+BENCH(normalize3f) {
+	nytl::Vec3f a {1.f, 2.f, 3.f};
+	for(auto _ : state) {
+		(void) _;
+		bench::doNotOptimize(nytl::normalized(a));
+	}
+}
+
+BENCH(sumDot1k) {
+	// accumulated dot over a contiguous array, the vectorizable case
+	std::vector<nytl::Vec4f> vecs(1024, {1.f, 2.f, 3.f, 4.f});
+	for(auto _ : state) {
+		(void) _;
+		auto sum = 0.f;
+		for(auto& v : vecs) {
+			sum += nytl::dot(v, v);
+		}
+
+		bench::doNotOptimize(sum);
+	}
+}
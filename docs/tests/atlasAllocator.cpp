@@ -0,0 +1,116 @@
+#include "test.hpp"
+#include <nytl/atlasAllocator.hpp>
+#include <nytl/rectOps.hpp>
+#include <random>
+#include <vector>
+
+using Atlas = nytl::AtlasAllocator<unsigned int>;
+
+// allocations must be disjoint and inside the atlas
+bool valid(const Atlas& atlas, const std::vector<nytl::Rect2ui>& rects) {
+	for(auto i = 0u; i < rects.size(); ++i) {
+		auto end = rects[i].position + rects[i].size;
+		if(end.x > atlas.extent().x || end.y > atlas.extent().y) {
+			return false;
+		}
+
+		for(auto j = i + 1; j < rects.size(); ++j) {
+			auto is = nytl::intersection(rects[i], rects[j]);
+			if(is.size.x > 0u && is.size.y > 0u) {
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+TEST(shelf) {
+	Atlas atlas({64u, 64u}, Atlas::Strategy::shelf);
+	EXPECT(atlas.occupancy(), 0.0);
+
+	std::vector<nytl::Rect2ui> rects;
+	for(auto i = 0u; i < 8u; ++i) {
+		auto rect = atlas.alloc({16u, 16u});
+		EXPECT(rect.size.x, 16u);
+		rects.push_back(rect);
+	}
+
+	EXPECT(valid(atlas, rects), true);
+	EXPECT(atlas.occupancy(), 0.5);
+
+	// full: 8 slots of 16x16 used two shelves, two more fit
+	EXPECT(atlas.alloc({64u, 33u}).size.x, 0u);
+
+	// freed slots get recycled
+	auto freed = rects[3];
+	atlas.free(freed);
+	auto again = atlas.alloc({16u, 16u});
+	EXPECT(again.position, freed.position);
+
+	// different heights go to different shelves
+	auto flat = atlas.alloc({64u, 8u});
+	EXPECT(flat.size.y, 8u);
+	EXPECT(flat.position.y >= 32u, true);
+}
+
+TEST(guillotine) {
+	Atlas atlas({128u, 128u});
+	auto a = atlas.alloc({64u, 64u});
+	auto b = atlas.alloc({64u, 64u});
+	auto c = atlas.alloc({64u, 64u});
+	auto d = atlas.alloc({64u, 64u});
+	EXPECT(valid(atlas, {a, b, c, d}), true);
+	EXPECT(atlas.occupancy(), 1.0);
+	EXPECT(atlas.alloc({1u, 1u}).size.x, 0u);
+
+	// merge-on-free: freeing everything allows a full-size alloc again
+	atlas.free(a);
+	atlas.free(b);
+	atlas.free(c);
+	atlas.free(d);
+	EXPECT(atlas.occupancy(), 0.0);
+	auto full = atlas.alloc({128u, 128u});
+	EXPECT(full.size.x, 128u);
+	atlas.free(full);
+
+	// oversized and empty requests fail
+	EXPECT(atlas.alloc({129u, 1u}).size.x, 0u);
+	EXPECT(atlas.alloc({0u, 16u}).size.x, 0u);
+}
+
+TEST(churn) {
+	// mixed alloc/free traffic keeps allocations disjoint and the
+	// atlas usable
+	Atlas atlas({256u, 256u});
+	std::mt19937 rng(42);
+	std::uniform_int_distribution<unsigned> dist(1u, 40u);
+
+	std::vector<nytl::Rect2ui> live;
+	for(auto i = 0u; i < 400u; ++i) {
+		if(live.size() > 40u || (live.size() > 4u && (rng() % 3u) == 0u)) {
+			auto idx = rng() % live.size();
+			atlas.free(live[idx]);
+			live[idx] = live.back();
+			live.pop_back();
+		} else {
+			auto rect = atlas.alloc({dist(rng), dist(rng)});
+			if(rect.size.x > 0u) {
+				live.push_back(rect);
+			}
+		}
+	}
+
+	EXPECT(valid(atlas, live), true);
+	EXPECT(atlas.occupancy() > 0.0, true);
+	EXPECT(atlas.occupancy() < 1.0, true);
+
+	while(!live.empty()) {
+		atlas.free(live.back());
+		live.pop_back();
+	}
+
+	EXPECT(atlas.occupancy(), 0.0);
+	auto full = atlas.alloc({256u, 256u});
+	EXPECT(full.size.x, 256u);
+}
@@ -0,0 +1,205 @@
+#include "test.hpp"
+#include <nytl/bytes.hpp>
+#include <memory_resource>
+
+TEST(endian) {
+	EXPECT(nytl::byteswap<std::uint16_t>(0x1234u), std::uint16_t(0x3412));
+	EXPECT(nytl::byteswap<std::uint32_t>(0x12345678u), 0x78563412u);
+	EXPECT(nytl::byteswap<std::uint64_t>(0x0102030405060708ull), 0x0807060504030201ull);
+
+	// explicit byte patterns
+	nytl::DynWriteBuf buf;
+	nytl::writeLE(buf, std::uint32_t(0x11223344));
+	nytl::writeBE(buf, std::uint32_t(0x11223344));
+	EXPECT(buf.size(), 8u);
+	EXPECT(buf[0], std::byte {0x44});
+	EXPECT(buf[3], std::byte {0x11});
+	EXPECT(buf[4], std::byte {0x11});
+	EXPECT(buf[7], std::byte {0x44});
+
+	nytl::ReadBuf src = buf;
+	EXPECT(nytl::readLE<std::uint32_t>(src), 0x11223344u);
+	EXPECT(nytl::readBE<std::uint32_t>(src), 0x11223344u);
+	EXPECT(src.empty(), true);
+
+	// span roundtrip through the opposite byte order
+	std::vector<std::uint32_t> indices(1000);
+	for(auto i = 0u; i < indices.size(); ++i) {
+		indices[i] = 3 * i;
+	}
+
+	buf.clear();
+	nytl::writeBE(buf, nytl::span<const std::uint32_t>(indices));
+	EXPECT(buf.size(), indices.size() * 4);
+
+	std::vector<std::uint32_t> decoded(indices.size());
+	src = buf;
+	nytl::readBE(src, nytl::span<std::uint32_t>(decoded));
+	EXPECT(src.empty(), true);
+	EXPECT(decoded == indices, true);
+
+	// floats roundtrip as well
+	buf.clear();
+	nytl::writeBE(buf, 1.5f);
+	src = buf;
+	EXPECT(nytl::readBE<float>(src), 1.5f);
+}
+
+TEST(serializedSize) {
+	static_assert(nytl::serializedSize(1.f) == 4);
+	static_assert(nytl::serializedSize(std::uint8_t {0}) == 1);
+
+	std::vector<float> v(10);
+	EXPECT(nytl::serializedSize(v), 40u);
+	EXPECT(nytl::serializedSize(nytl::span<const float>(v)), 40u);
+
+	// reserving via summed sizes avoids growth during serialization
+	nytl::DynWriteBuf buf;
+	buf.reserve(nytl::serializedSize(42u) + nytl::serializedSize(v));
+	auto cap = buf.capacity();
+	nytl::write(buf, 42u);
+	nytl::write(buf, v);
+	EXPECT(buf.capacity(), cap);
+	EXPECT(buf.size(), 44u);
+}
+
+TEST(arena) {
+	std::pmr::unsynchronized_pool_resource pool;
+	nytl::ArenaWriteBuf buf(64, &pool); // tiny pages to force growth
+	EXPECT(buf.empty(), true);
+
+	std::vector<std::uint32_t> values(100);
+	for(auto i = 0u; i < values.size(); ++i) {
+		values[i] = i;
+	}
+
+	nytl::write(buf, 7.f);
+	nytl::write(buf, values); // spans multiple pages
+	EXPECT(buf.size(), 404u);
+	EXPECT(buf.pageCount(), 7u);
+	EXPECT(buf.page(0).size(), 64u);
+	EXPECT(buf.page(6).size(), 404u - 6 * 64u);
+
+	// flatten and read back
+	nytl::DynWriteBuf flat(buf.size());
+	buf.copyTo(flat);
+	nytl::ReadBuf src = flat;
+	EXPECT(nytl::read<float>(src), 7.f);
+	std::vector<std::uint32_t> decoded(values.size());
+	nytl::read(src, decoded);
+	EXPECT(decoded == values, true);
+	EXPECT(src.empty(), true);
+
+	// clear keeps the pages for reuse; retained pages past the new
+	// write position are empty and copyTo only touches the used ones
+	buf.clear();
+	EXPECT(buf.empty(), true);
+	EXPECT(buf.pageCount(), 7u);
+
+	nytl::write(buf, 42.0);
+	EXPECT(buf.page(0).size(), 8u);
+	EXPECT(buf.page(1).size(), std::size_t(0));
+	EXPECT(buf.page(6).size(), std::size_t(0));
+
+	std::byte small[8];
+	buf.copyTo(nytl::WriteBuf(small));
+	nytl::ReadBuf redo = small;
+	EXPECT(nytl::read<double>(redo), 42.0);
+
+	auto buf2 = std::move(buf);
+	EXPECT(buf2.pageCount(), 7u);
+	EXPECT(buf.pageCount(), 0u);
+}
+
+TEST(gather) {
+	std::vector<float> payload(64, 1.5f); // 256 bytes, above threshold
+
+	nytl::GatherWriteBuf buf;
+	nytl::write(buf, 42u); // copied
+	nytl::write(buf, 7.f); // copied, coalesced with the previous write
+	nytl::write(buf, payload); // large: referenced, not copied
+	nytl::write<std::uint8_t>(buf, 3u); // copied, new segment
+
+	EXPECT(buf.size(), 8u + payload.size() * sizeof(float) + 1u);
+
+	auto segs = buf.segments();
+	EXPECT(segs.size(), 3u);
+	EXPECT(segs[0].length, 8u);
+	EXPECT(segs[1].base, static_cast<const void*>(payload.data()));
+	EXPECT(segs[1].length, payload.size() * sizeof(float));
+	EXPECT(segs[2].length, 1u);
+
+	// flattened, it reads back like a DynWriteBuf would
+	auto flat = buf.gather();
+	EXPECT(flat.size(), buf.size());
+	nytl::ReadBuf src = flat;
+	EXPECT(nytl::read<unsigned>(src), 42u);
+	EXPECT(nytl::read<float>(src), 7.f);
+	for(auto i = 0u; i < payload.size(); ++i) {
+		EXPECT(nytl::read<float>(src), 1.5f);
+	}
+	EXPECT(nytl::read<std::uint8_t>(src), std::uint8_t(3));
+	EXPECT(src.empty(), true);
+
+	buf.clear();
+	EXPECT(buf.empty(), true);
+	EXPECT(buf.segments().empty(), true);
+}
+
+TEST(views) {
+	nytl::DynWriteBuf buf;
+	nytl::write(buf, 7u);
+	const char hello[] = {'h', 'e', 'l', 'l', 'o'};
+	nytl::write(buf, nytl::ReadBuf(nytl::bytes(nytl::span<const char>(hello))));
+	nytl::write(buf, 1.5f);
+
+	// views alias the buffer instead of copying
+	nytl::ReadBuf src = buf;
+	EXPECT(nytl::read<unsigned>(src), 7u);
+	auto view = nytl::readStringView(src, 5);
+	EXPECT(view, std::string_view("hello"));
+	EXPECT(static_cast<const void*>(view.data()),
+		static_cast<const void*>(buf.data() + 4));
+	EXPECT(nytl::read<float>(src), 1.5f);
+	EXPECT(src.empty(), true);
+
+	// lazy access: skip straight to the last field
+	src = buf;
+	nytl::skip(src, 4 + 5);
+	EXPECT(nytl::read<float>(src), 1.5f);
+}
+
+TEST(frames) {
+	nytl::DynWriteBuf buf;
+	const char first[] = {'a', 'b', 'c'};
+	const char second[] = {'x', 'y'};
+	nytl::writeFrame(buf, nytl::bytes(nytl::span<const char>(first)));
+	nytl::writeFrame(buf, nytl::bytes(nytl::span<const char>(second)), false);
+
+	nytl::ReadBuf src = buf;
+	nytl::ReadBuf payload;
+	EXPECT(nytl::readFrame(src, payload) == nytl::FrameResult::ok, true);
+	EXPECT(payload.size(), 3u);
+	{
+		auto view = nytl::readStringView(payload, 3);
+		EXPECT(view, std::string_view("abc"));
+	}
+
+	// second frame has no checksum, still validates
+	EXPECT(nytl::readFrame(src, payload) == nytl::FrameResult::ok, true);
+	EXPECT(payload.size(), 2u);
+	EXPECT(src.empty(), true);
+
+	// a partial frame reports incomplete and leaves src unchanged
+	nytl::ReadBuf partial = {buf.data(), 5};
+	EXPECT(nytl::readFrame(partial, payload) == nytl::FrameResult::incomplete, true);
+	EXPECT(partial.size(), 5u);
+
+	// flipping a payload bit is caught by the checksum
+	auto broken = buf;
+	broken[nytl::frameHeaderSize] ^= std::byte {1};
+	src = broken;
+	EXPECT(nytl::readFrame(src, payload) == nytl::FrameResult::corrupt, true);
+	EXPECT(src.size(), broken.size());
+	EXPECT(nytl::readFrame(src, payload, false) == nytl::FrameResult::ok, true);
+}
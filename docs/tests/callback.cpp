@@ -1,6 +1,7 @@
 #include "test.hpp"
 #include <nytl/callback.hpp>
 #include <nytl/tmpUtil.hpp>
+#include <array>
 
 
 // TODO: more testing with custom id type and stuff
@@ -104,4 +105,73 @@ TEST(tracked) {
 	}
 
 	EXPECT(conn.connected(), false);
-}
\ No newline at end of file
+}
+TEST(delegate) {
+	// inline stored capture
+	auto called = 0u;
+	nytl::Delegate<void(int)> del = [&](int i) { called += i; };
+	EXPECT(static_cast<bool>(del), true);
+	del(2);
+	EXPECT(called, 2u);
+
+	// move semantics
+	auto del2 = std::move(del);
+	EXPECT(static_cast<bool>(del), false);
+	del2(3);
+	EXPECT(called, 5u);
+
+	del2.reset();
+	EXPECT(static_cast<bool>(del2), false);
+
+	// capture larger than the inline buffer, heap fallback
+	std::array<unsigned, 32> big {};
+	big[31] = 1u;
+	nytl::Delegate<unsigned()> delBig = [big]{ return big[31]; };
+	EXPECT(delBig(), 1u);
+}
+
+TEST(delegateCallback) {
+	auto called = 0u;
+	nytl::DelegateCallback<void()> cb;
+	auto conn = cb.add([&]{ ++called; });
+	cb.add([&]{ ++called; });
+	cb();
+	EXPECT(called, 2u);
+
+	conn.disconnect();
+	cb();
+	EXPECT(called, 3u);
+}
+
+TEST(callInto) {
+	nytl::Callback<int()> cb;
+	cb.add([]{ return 1; });
+	cb.add([]{ return 2; });
+	cb.add([]{ return 3; });
+
+	std::array<int, 8> results {};
+	EXPECT(cb.callInto(results), 3u);
+	EXPECT(results[0], 1);
+	EXPECT(results[1], 2);
+	EXPECT(results[2], 3);
+
+	// smaller span: all functions called, only two results written
+	std::array<int, 2> small {};
+	EXPECT(cb.callInto(small), 2u);
+	EXPECT(small[0], 1);
+	EXPECT(small[1], 2);
+}
+
+TEST(callFold) {
+	nytl::Callback<int(int)> cb;
+	cb.add([](int i) { return i; });
+	cb.add([](int i) { return 2 * i; });
+	cb.add([](int i) { return 3 * i; });
+
+	auto sum = cb.callFold(0, [](int a, int b) { return a + b; }, 2);
+	EXPECT(sum, 12);
+
+	auto all = cb.callFold(true,
+		[](bool a, int b) { return a && b > 0; }, 1);
+	EXPECT(all, true);
+}
@@ -0,0 +1,55 @@
+#include "test.hpp"
+#include <nytl/concurrentCallback.hpp>
+#include <atomic>
+#include <thread>
+
+TEST(basic) {
+	// same single-threaded semantics as nytl::Callback
+	nytl::ConcurrentCallback<int()> cb;
+	auto conn = cb.add([]{ return 1; });
+	cb.add([]{ return 2; });
+
+	auto ret = cb();
+	EXPECT(ret.size(), 2u);
+	EXPECT(ret[0], 1);
+	EXPECT(ret[1], 2);
+
+	EXPECT(cb.disconnect(conn.id()), true);
+	EXPECT(cb.disconnect(conn.id()), false);
+	EXPECT(cb().size(), 1u);
+
+	cb.clear();
+	EXPECT(cb().size(), 0u);
+
+	ERROR(cb.add(std::function<int()>{}), std::invalid_argument);
+}
+
+TEST(concurrent) {
+	// workers churn connect/disconnect pairs while the main thread emits
+	nytl::ConcurrentCallback<void()> cb;
+	std::atomic<unsigned> called {0};
+	std::atomic<bool> run {true};
+	cb.add([&]{ ++called; });
+
+	std::thread workers[4];
+	for(auto& worker : workers) {
+		worker = std::thread([&]{
+			while(run.load()) {
+				auto conn = cb.add([&]{ ++called; });
+				conn.disconnect();
+			}
+		});
+	}
+
+	for(auto i = 0u; i < 1000; ++i) {
+		cb();
+	}
+
+	run.store(false);
+	for(auto& worker : workers) {
+		worker.join();
+	}
+
+	// the permanent function was called every emission
+	EXPECT(called.load() >= 1000u, true);
+}
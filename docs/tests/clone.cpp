@@ -136,4 +136,31 @@ TEST(clone4) {
 	auto b = nytl::cloneMove(a);
 	EXPECT(b->get().size(), 5u);
 	EXPECT(a.vals.empty(), true);
+}
+
+// arena cloning
+TEST(cloneArena) {
+	std::pmr::monotonic_buffer_resource arena;
+
+	auto derived = CloneDerived {};
+	derived.value_ = 42;
+	auto ptr = static_cast<CloneBase*>(&derived);
+
+	auto copy = nytl::cloneInto(arena, *ptr);
+	EXPECT(copy->value(), 42);
+	EXPECT(dynamic_cast<CloneDerived*>(copy.get()) == nullptr, false);
+
+	// many clones land in the same arena blocks
+	std::vector<nytl::ArenaPtr<CloneBase>> copies;
+	for(auto i = 0u; i < 100; ++i) {
+		copies.push_back(nytl::cloneInto(arena, *ptr));
+	}
+	EXPECT(copies[99]->value(), 42);
+
+	// move-cloning into an arena really moves
+	Derived4 movable {};
+	movable.vals = {1, 2, 3};
+	auto moved = nytl::cloneMoveInto(arena, movable);
+	EXPECT(moved->get().size(), 3u);
+	EXPECT(movable.vals.empty(), true);
 }
\ No newline at end of file
@@ -0,0 +1,61 @@
+#include "test.hpp"
+#include <nytl/colMat.hpp>
+#include <nytl/matOps.hpp>
+#include <nytl/bytes.hpp>
+#include <nytl/approx.hpp>
+#include <nytl/approxVec.hpp>
+
+TEST(layout) {
+	// memory order is column-major, i.e. upload layout
+	auto m = nytl::colMajor(nytl::Mat2i {1, 2, 3, 4});
+	EXPECT(m(0, 0), 1);
+	EXPECT(m(0, 1), 2);
+	EXPECT(m(1, 0), 3);
+	EXPECT(m(1, 1), 4);
+
+	nytl::ReadBuf src = nytl::bytes(m);
+	int flat[4];
+	nytl::read(src, nytl::bytes(nytl::span<int>(flat)));
+	EXPECT(flat[0], 1);
+	EXPECT(flat[1], 3);
+	EXPECT(flat[2], 2);
+	EXPECT(flat[3], 4);
+
+	// accessors
+	EXPECT(m.col(0), (nytl::Vec2i {1, 3}));
+	EXPECT(m.row(0), (nytl::Vec2i {1, 2}));
+	EXPECT(m.at(1, 0), 3);
+	ERROR(m.at(2, 0), std::out_of_range);
+
+	// round trip back to row-major
+	EXPECT(nytl::rowMajor(m), (nytl::Mat2i {1, 2, 3, 4}));
+}
+
+TEST(arithmetic) {
+	auto a = nytl::Mat3d {1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0, 10.0};
+	auto b = nytl::Mat3d {0.5, -1.0, 2.0, 1.5, 0.0, -2.5, 3.0, 1.0, 0.25};
+	auto ca = nytl::colMajor(a);
+	auto cb = nytl::colMajor(b);
+
+	// all operators agree with the row-major results
+	EXPECT(nytl::rowMajor(ca * cb), nytl::approx(a * b));
+	EXPECT(nytl::rowMajor(ca + cb), nytl::approx(a + b));
+	EXPECT(nytl::rowMajor(ca - cb), nytl::approx(a - b));
+	EXPECT(nytl::rowMajor(2.0 * ca), nytl::approx(2.0 * a));
+	EXPECT(nytl::rowMajor(-ca), nytl::approx(-a));
+
+	auto v = nytl::Vec3d {1.0, -2.0, 0.5};
+	EXPECT(ca * v, nytl::approx(a * v));
+
+	auto acc = ca;
+	acc *= cb;
+	EXPECT(nytl::rowMajor(acc), nytl::approx(a * b));
+
+	EXPECT(nytl::rowMajor(nytl::transpose(ca)), nytl::approx(nytl::transpose(a)));
+	EXPECT(ca == nytl::colMajor(a), true);
+	EXPECT(ca != cb, true);
+
+	// identity
+	auto id = nytl::colIdentity<3, double>();
+	EXPECT(nytl::rowMajor(id * ca), nytl::approx(a));
+}
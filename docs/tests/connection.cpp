@@ -1,6 +1,8 @@
 #include "test.hpp"
 #include <nytl/connection.hpp>
 #include <nytl/callback.hpp>
+#include <nytl/recursiveCallback.hpp>
+#include <nytl/concurrentCallback.hpp>
 
 TEST(basic) {
 	nytl::Connection basic;
@@ -34,3 +36,111 @@ TEST(tracked) {
 	EXPECT(tracked.connected(), false);
 	EXPECT(trackedCopy.connected(), false);
 }
+
+TEST(slot) {
+	// tracks removal like TrackedConnectionID, without allocating
+	nytl::SlotConnection slot;
+	nytl::SlotConnection slotCopy;
+
+	{
+		nytl::Callback<void(), nytl::SlotConnectionID> connectable;
+		slot = connectable.add([]{});
+		slotCopy = slot;
+		EXPECT(slot.connected(), true);
+		EXPECT(slotCopy.connected(), true);
+
+		// explicit disconnect invalidates all copies
+		auto second = connectable.add([]{});
+		slot.disconnect();
+		EXPECT(slotCopy.connected(), false);
+		EXPECT(second.connected(), true);
+
+		// a new connection reusing the slot gets a fresh generation
+		auto third = connectable.add([]{});
+		EXPECT(third.connected(), true);
+		EXPECT(slotCopy.connected(), false);
+	}
+
+	// callback destruction releases the remaining slots
+	EXPECT(slot.connected(), false);
+	EXPECT(slotCopy.connected(), false);
+}
+
+TEST(set) {
+	nytl::Callback<void()> cbA;
+	nytl::Callback<void()> cbB;
+	auto calledA = 0u, calledB = 0u;
+
+	{
+		nytl::ConnectionSet set;
+		set += cbA.add([&]{ ++calledA; });
+		set += cbA.add([&]{ ++calledA; });
+		set += cbB.add([&]{ ++calledB; });
+		EXPECT(set.size(), 3u);
+
+		// one subscription removed behind the set's back
+		auto extra = cbA.add([&]{ ++calledA; });
+		set.add(extra);
+		extra.disconnect();
+		EXPECT(set.size(), 4u);
+
+		cbA();
+		cbB();
+		EXPECT(calledA, 2u);
+		EXPECT(calledB, 1u);
+
+		// explicit batched teardown: only the still-connected three found
+		EXPECT(set.disconnect(), 3u);
+		EXPECT(set.empty(), true);
+	}
+
+	cbA();
+	cbB();
+	EXPECT(calledA, 2u);
+	EXPECT(calledB, 1u);
+
+	// destruction disconnects, too
+	{
+		nytl::ConnectionSet set;
+		set += cbA.add([&]{ ++calledA; });
+	}
+
+	cbA();
+	EXPECT(calledA, 2u);
+}
+
+TEST(bulkDisconnect) {
+	nytl::Callback<void()> cb;
+	auto called = 0u;
+	auto c1 = cb.add([&]{ ++called; });
+	auto c2 = cb.add([&]{ ++called; });
+	auto c3 = cb.add([&]{ ++called; });
+
+	nytl::ConnectionID ids[] = {c1.id(), c3.id(), {}};
+	EXPECT(cb.disconnect(nytl::span<const nytl::ConnectionID>(ids)), 2u);
+	cb();
+	EXPECT(called, 1u);
+
+	// already removed ids are not found again
+	EXPECT(cb.disconnect(nytl::span<const nytl::ConnectionID>(ids)), 0u);
+	EXPECT(cb.disconnect(c2.id()), true);
+	cb();
+	EXPECT(called, 1u);
+
+	// the bulk overload is callable on the concrete types of the whole
+	// callback family, not just through ConnectableT
+	nytl::RecursiveCallback<void()> rc;
+	auto r1 = rc.add([&]{ ++called; });
+	auto r2 = rc.add([&]{ ++called; });
+	nytl::ConnectionID rids[] = {r1.id(), r2.id()};
+	EXPECT(rc.disconnect(nytl::span<const nytl::ConnectionID>(rids)), 2u);
+	rc();
+	EXPECT(called, 1u);
+
+	nytl::ConcurrentCallback<void()> cc;
+	auto n1 = cc.add([&]{ ++called; });
+	nytl::ConnectionID cids[] = {n1.id()};
+	EXPECT(cc.disconnect(nytl::span<const nytl::ConnectionID>(cids)), 1u);
+	cc();
+	EXPECT(called, 1u);
+}
@@ -0,0 +1,109 @@
+#include "test.hpp"
+#include <nytl/deferredCallback.hpp>
+#include <string>
+#include <vector>
+
+TEST(basic) {
+	nytl::DeferredCallback<void(int)> dc;
+	std::vector<int> seen;
+	dc.add([&](int i) { seen.push_back(i); });
+
+	// nothing dispatched before flush
+	dc(1);
+	dc.enqueue(2);
+	dc(3);
+	EXPECT(seen.empty(), true);
+	EXPECT(dc.pending(), 3u);
+	EXPECT(dc.highWater(), 3u);
+
+	EXPECT(dc.flush(), 3u);
+	EXPECT(seen, (std::vector {1, 2, 3}));
+	EXPECT(dc.pending(), 0u);
+	EXPECT(dc.highWater(), 3u);
+
+	// empty flush is a no-op
+	EXPECT(dc.flush(), 0u);
+
+	// discard drops events without dispatching
+	dc(4);
+	dc.discard();
+	EXPECT(dc.flush(), 0u);
+	EXPECT(seen.size(), 3u);
+}
+
+TEST(listenerMajor) {
+	// each listener sees the whole batch in order before the next one
+	nytl::DeferredCallback<void(int)> dc;
+	std::vector<std::pair<int, int>> order; // (listener, event)
+	dc.add([&](int i) { order.push_back({0, i}); });
+	dc.add([&](int i) { order.push_back({1, i}); });
+
+	dc(1);
+	dc(2);
+	EXPECT(dc.flush(), 2u);
+	EXPECT(order, (std::vector<std::pair<int, int>> {
+		{0, 1}, {0, 2}, {1, 1}, {1, 2}}));
+}
+
+TEST(reentrant) {
+	// events enqueued during a flush go to the next batch
+	nytl::DeferredCallback<void(int)> dc;
+	auto sum = 0;
+	dc.add([&](int i) {
+		sum += i;
+		if(i < 3) {
+			dc(i + 1);
+		}
+	});
+
+	dc(1);
+	EXPECT(dc.flush(), 1u);
+	EXPECT(sum, 1);
+	EXPECT(dc.pending(), 1u);
+	EXPECT(dc.flush(), 1u);
+	EXPECT(dc.flush(), 1u);
+	EXPECT(dc.flush(), 0u);
+	EXPECT(sum, 6);
+}
+
+TEST(throwing) {
+	// a throwing listener propagates but the batch still counts as
+	// consumed, the next flush must not re-dispatch it
+	nytl::DeferredCallback<void(int)> dc;
+	std::vector<int> seen;
+	dc.add([&](int i) {
+		if(i == 2) {
+			throw std::runtime_error("listener");
+		}
+
+		seen.push_back(i);
+	});
+
+	dc(1);
+	dc(2);
+	dc(3);
+	ERROR(dc.flush(), std::runtime_error);
+	EXPECT(seen, (std::vector {1}));
+	EXPECT(dc.pending(), 0u);
+
+	dc(4);
+	EXPECT(dc.flush(), 1u);
+	EXPECT(seen, (std::vector {1, 4}));
+}
+
+TEST(nonTrivial) {
+	// non-trivial argument types are stored by value in the queue
+	nytl::DeferredCallback<void(const std::string&)> dc;
+	std::string all;
+	dc.add([&](const std::string& s) { all += s; });
+
+	{
+		std::string tmp = "hello ";
+		dc(tmp);
+		tmp = "world";
+		dc(tmp);
+	}
+
+	EXPECT(dc.flush(), 2u);
+	EXPECT(all, std::string("hello world"));
+}
@@ -0,0 +1,102 @@
+#include "test.hpp"
+#include <nytl/dualQuaternion.hpp>
+#include <nytl/approxVec.hpp>
+#include <vector>
+
+TEST(basic) {
+	// identity transforms nothing
+	nytl::DualQuaternion id;
+	EXPECT(nytl::apply(id, nytl::Vec3d {1.0, 2.0, 3.0}),
+		nytl::approx(nytl::Vec3d {1.0, 2.0, 3.0}));
+	EXPECT(nytl::translation(id), nytl::approx(nytl::Vec3d {0.0, 0.0, 0.0}));
+
+	// rotation then translation, like the factory promises
+	auto rot = nytl::Quaternion::axisAngle(0, 0, 1, 0.5 * 3.141592653589793);
+	auto dq = nytl::DualQuaternion::fromRotationTranslation(rot, {1.0, 0.0, 0.0});
+	EXPECT(nytl::translation(dq), nytl::approx(nytl::Vec3d {1.0, 0.0, 0.0}, 0.0001));
+	EXPECT(nytl::apply(dq, nytl::Vec3d {1.0, 0.0, 0.0}),
+		nytl::approx(nytl::Vec3d {1.0, 1.0, 0.0}, 0.0001));
+
+	// agrees with the quaternion transform plus translation
+	auto p = nytl::Vec3d {0.5, -2.0, 1.0};
+	EXPECT(nytl::apply(dq, p),
+		nytl::approx(nytl::apply(rot, p) + nytl::Vec3d {1.0, 0.0, 0.0}, 0.0001));
+
+	// conjugate inverts the transform
+	EXPECT(nytl::apply(nytl::conjugated(dq), nytl::apply(dq, p)),
+		nytl::approx(p, 0.0001));
+}
+
+TEST(composition) {
+	auto rotA = nytl::Quaternion::axisAngle(0, 1, 0, 0.7);
+	auto rotB = nytl::Quaternion::axisAngle(1, 0, 0, -0.3);
+	auto a = nytl::DualQuaternion::fromRotationTranslation(rotA, {1.0, 2.0, 3.0});
+	auto b = nytl::DualQuaternion::fromRotationTranslation(rotB, {-2.0, 0.5, 0.0});
+
+	// (a * b) applies b first, like quaternions and matrices
+	auto p = nytl::Vec3d {0.25, 1.0, -0.75};
+	EXPECT(nytl::apply(a * b, p),
+		nytl::approx(nytl::apply(a, nytl::apply(b, p)), 0.0001));
+
+	// matches the matrix composition
+	auto mat = nytl::toMat<4, double>(a) * nytl::toMat<4, double>(b);
+	auto hom = mat * nytl::Vec4d {p.x, p.y, p.z, 1.0};
+	EXPECT(nytl::apply(a * b, p),
+		nytl::approx(nytl::Vec3d {hom[0], hom[1], hom[2]}, 0.0001));
+}
+
+TEST(blend) {
+	// blending an identity with a pure translation moves linearly
+	auto from = nytl::DualQuaternion {};
+	auto to = nytl::DualQuaternion::fromTranslation({2.0, 0.0, 0.0});
+
+	const nytl::DualQuaternion pair[] = {from, to};
+	const double weights[] = {0.75, 0.25};
+	auto mid = nytl::dlb(pair, weights);
+	EXPECT(nytl::translation(mid), nytl::approx(nytl::Vec3d {0.5, 0.0, 0.0}, 0.0001));
+
+	// antipodal representation blends to the same transform
+	auto flipped = to;
+	flipped.real = -1.0 * flipped.real;
+	flipped.dual = -1.0 * flipped.dual;
+	const nytl::DualQuaternion pairFlipped[] = {from, flipped};
+	auto mid2 = nytl::dlb(pairFlipped, weights);
+	EXPECT(nytl::apply(mid2, nytl::Vec3d {0.0, 0.0, 0.0}),
+		nytl::approx(nytl::apply(mid, nytl::Vec3d {0.0, 0.0, 0.0}), 0.0001));
+
+	// blended rotations stay rigid (unit real part)
+	auto rot = nytl::Quaternion::axisAngle(0, 0, 1, 1.2);
+	const nytl::DualQuaternion rotPair[] = {
+		from, nytl::DualQuaternion::fromRotationTranslation(rot, {0.0, 1.0, 0.0})};
+	const double half[] = {0.5, 0.5};
+	auto blended = nytl::dlb(rotPair, half);
+	EXPECT(nytl::norm(blended.real), nytl::approx(1.0, 0.0001));
+}
+
+TEST(batch) {
+	// batch skinning palette blend matches the scalar dlb
+	std::vector<nytl::DualQuaternion> palette {
+		{},
+		nytl::DualQuaternion::fromRotationTranslation(
+			nytl::Quaternion::axisAngle(0, 1, 0, 0.9), {1.0, 0.0, 0.0}),
+		nytl::DualQuaternion::fromTranslation({0.0, 0.0, 4.0}),
+	};
+
+	constexpr auto influences = 2u;
+	std::vector<std::uint32_t> indices {0, 1, 1, 2, 2, 0};
+	std::vector<double> weights {0.5, 0.5, 0.25, 0.75, 0.9, 0.1};
+
+	std::vector<nytl::DualQuaternion> out(3);
+	nytl::dlb(palette, indices, weights, influences,
+		nytl::span<nytl::DualQuaternion>(out));
+
+	for(auto i = 0u; i < out.size(); ++i) {
+		const nytl::DualQuaternion pair[] = {
+			palette[indices[influences * i]],
+			palette[indices[influences * i + 1]]};
+		auto scalar = nytl::dlb(pair,
+			nytl::span<const double>(weights.data() + influences * i, 2));
+		auto p = nytl::Vec3d {1.0, 2.0, 3.0};
+		EXPECT(nytl::apply(out[i], p), nytl::approx(nytl::apply(scalar, p), 0.0001));
+	}
+}
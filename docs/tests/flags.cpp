@@ -27,3 +27,40 @@ TEST(flags) {
 	static_assert(static_cast<unsigned int>(entry23) == 6, "flags cast test 1");
 	static_assert(static_cast<int>(entry3) == 4, "flags cast test 1");
 }
+
+TEST(bits) {
+	constexpr auto entry23 = Enum::entry2 | Enum::entry3;
+	static_assert(nytl::bitCount(entry23) == 2, "flags bitCount");
+	static_assert(nytl::lowestBit(entry23) == Enum::entry2, "flags lowestBit");
+	static_assert(nytl::bitCount(nytl::Flags<Enum> {}) == 0, "empty bitCount");
+
+	auto seen = 0u;
+	for(auto bit : nytl::bits(entry23)) {
+		seen |= static_cast<unsigned int>(bit);
+	}
+	EXPECT(seen, 6u);
+
+	auto count = 0u;
+	nytl::forEachFlag(entry23 | Enum::entry1, [&](Enum) { ++count; });
+	EXPECT(count, 3u);
+
+	// empty flags yield nothing
+	nytl::forEachFlag(nytl::Flags<Enum> {}, [&](Enum) { ++count; });
+	EXPECT(count, 3u);
+}
+
+TEST(compileTime) {
+	constexpr auto entry13 = Enum::entry1 | Enum::entry3;
+
+	auto seen = 0u;
+	nytl::forEachFlag<entry13.value()>([&](auto bit) {
+		static_assert(bit() == 1 || bit() == 4, "only set bits");
+		seen |= bit();
+	});
+	EXPECT(seen, 5u);
+
+	// also works directly with a plain enum value
+	nytl::forEachFlag<Enum::entry2>([&](auto bit) {
+		static_assert(bit() == Enum::entry2, "single bit");
+	});
+}
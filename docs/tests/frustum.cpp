@@ -0,0 +1,87 @@
+#include "test.hpp"
+#include <nytl/frustum.hpp>
+#include <nytl/transform.hpp>
+#include <vector>
+
+TEST(points) {
+	auto proj = nytl::perspective<float>(nytl::radians(70.f), 1.f, 0.1f, 100.f);
+	auto frustum = nytl::Frustumf(proj);
+
+	// radius-zero spheres must agree with the clip-space definition,
+	// checked over a coarse grid (skipping near-boundary points where
+	// float rounding could make either answer correct)
+	for(auto x = -20; x <= 20; x += 4) {
+		for(auto y = -20; y <= 20; y += 4) {
+			for(auto z = -120; z <= 120; z += 7) {
+				auto p = nytl::Vec3f {float(x), float(y), float(z)};
+				auto clip = proj * nytl::Vec4f {p.x, p.y, p.z, 1.f};
+				auto w = clip[3];
+				auto margin = 0.01f * std::abs(w);
+
+				auto inside = w > 0.f
+					&& std::abs(clip[0]) < w - margin
+					&& std::abs(clip[1]) < w - margin
+					&& clip[2] > margin && clip[2] < w - margin;
+				auto outside = w <= 0.f
+					|| std::abs(clip[0]) > w + margin
+					|| std::abs(clip[1]) > w + margin
+					|| clip[2] < -margin || clip[2] > w + margin;
+
+				auto visible = frustum.intersects(nytl::Spheref {p, 0.f});
+				if(inside) {
+					EXPECT(visible, true);
+				} else if(outside) {
+					EXPECT(visible, false);
+				}
+			}
+		}
+	}
+}
+
+TEST(volumes) {
+	auto proj = nytl::perspective<float>(nytl::radians(70.f), 1.f, 0.1f, 100.f);
+	auto frustum = nytl::Frustumf(proj);
+
+	// positive near/far means the frustum looks down +z; a sphere
+	// straddling the near plane is visible, one behind the camera not
+	EXPECT(frustum.intersects(nytl::Spheref {{0.f, 0.f, 0.f}, 1.f}), true);
+	EXPECT(frustum.intersects(nytl::Spheref {{0.f, 0.f, -50.f}, 1.f}), false);
+
+	// boxes: one around a visible point, one far off to the side
+	EXPECT(frustum.intersects(
+		nytl::Rect<3, float> {{-1.f, -1.f, 10.f}, {2.f, 2.f, 2.f}}), true);
+	EXPECT(frustum.intersects(
+		nytl::Rect<3, float> {{500.f, 0.f, 10.f}, {2.f, 2.f, 2.f}}), false);
+}
+
+TEST(batch) {
+	auto proj = nytl::perspective<float>(nytl::radians(70.f), 1.f, 0.1f, 100.f);
+	auto frustum = nytl::Frustumf(proj);
+
+	std::vector<nytl::Spheref> spheres(130);
+	for(auto i = 0u; i < spheres.size(); ++i) {
+		// alternates between in front of and behind the camera
+		auto z = (i % 2) ? 10.f : -10.f;
+		spheres[i] = {{0.f, 0.f, z}, 0.5f};
+	}
+
+	std::uint64_t visible[3] = {};
+	frustum.cull(nytl::span<const nytl::Spheref>(spheres),
+		nytl::span<std::uint64_t>(visible));
+
+	for(auto i = 0u; i < spheres.size(); ++i) {
+		auto bit = (visible[i / 64] >> (i % 64)) & 1u;
+		EXPECT(bit, std::uint64_t(frustum.intersects(spheres[i])));
+		EXPECT(bit, std::uint64_t(i % 2));
+	}
+
+	// an oversized mask must not read past the spheres, its unused
+	// words are zeroed
+	spheres.resize(100);
+	std::uint64_t large[4] = {~std::uint64_t(0), ~std::uint64_t(0),
+		~std::uint64_t(0), ~std::uint64_t(0)};
+	frustum.cull(nytl::span<const nytl::Spheref>(spheres),
+		nytl::span<std::uint64_t>(large));
+	EXPECT(large[2], std::uint64_t(0));
+	EXPECT(large[3], std::uint64_t(0));
+}
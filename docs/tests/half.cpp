@@ -0,0 +1,75 @@
+#include "test.hpp"
+#include <nytl/half.hpp>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+TEST(basic) {
+	EXPECT(float(nytl::Half(0.f)), 0.f);
+	EXPECT(float(nytl::Half(1.f)), 1.f);
+	EXPECT(float(nytl::Half(-2.f)), -2.f);
+	EXPECT(float(nytl::Half(0.5f)), 0.5f);
+	EXPECT(nytl::Half(1.f).bits(), std::uint16_t(0x3c00));
+	EXPECT(nytl::Half(-0.f).bits(), std::uint16_t(0x8000));
+
+	// largest finite half
+	EXPECT(float(nytl::Half(65504.f)), 65504.f);
+
+	// smallest normal and a subnormal, both exactly representable
+	EXPECT(float(nytl::Half(6.103515625e-05f)), 6.103515625e-05f);
+	EXPECT(float(nytl::Half(5.960464477539063e-08f)),
+		5.960464477539063e-08f);
+}
+
+TEST(rounding) {
+	// 1 + 2^-11 lies exactly between 1 and the next half,
+	// ties round to even (here: down to 1)
+	EXPECT(float(nytl::Half(1.00048828125f)), 1.f);
+
+	// just above the tie rounds up
+	EXPECT(float(nytl::Half(1.00049f)), 1.0009765625f);
+
+	// overflow becomes infinity
+	EXPECT(std::isinf(float(nytl::Half(70000.f))), true);
+	EXPECT(std::isinf(float(nytl::Half(-1e10f))), true);
+
+	// too small for a subnormal flushes to zero
+	EXPECT(float(nytl::Half(1e-9f)), 0.f);
+}
+
+TEST(special) {
+	auto inf = std::numeric_limits<float>::infinity();
+	EXPECT(std::isinf(float(nytl::Half(inf))), true);
+	EXPECT(float(nytl::Half(-inf)) < 0.f, true);
+	EXPECT(std::isnan(float(nytl::Half(std::nanf("")))), true);
+}
+
+TEST(bulk) {
+	std::vector<float> src(1027);
+	for(auto i = 0u; i < src.size(); ++i) {
+		src[i] = 0.25f * float(i) - 100.f;
+	}
+
+	std::vector<nytl::Half> halves(src.size());
+	nytl::convert(nytl::span<const float>(src),
+		nytl::span<nytl::Half>(halves));
+
+	std::vector<float> back(src.size());
+	nytl::convert(nytl::span<const nytl::Half>(halves),
+		nytl::span<float>(back));
+
+	for(auto i = 0u; i < src.size(); ++i) {
+		EXPECT(back[i], src[i]); // all values exactly representable
+	}
+}
+
+TEST(vecs) {
+	std::vector<nytl::Vec4f> colors(33, nytl::Vec4f {0.25f, 0.5f, 0.75f, 1.f});
+	std::vector<nytl::Vec4h> packed(colors.size());
+	nytl::convert(nytl::span<const nytl::Vec4f>(colors),
+		nytl::span<nytl::Vec4h>(packed));
+
+	EXPECT(float(packed[17][0]), 0.25f);
+	EXPECT(float(packed[32][3]), 1.f);
+	EXPECT(sizeof(nytl::Vec4h), std::size_t(8));
+}
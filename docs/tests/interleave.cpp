@@ -0,0 +1,75 @@
+#include "test.hpp"
+#include <nytl/interleave.hpp>
+#include <nytl/vec.hpp>
+#include <nytl/vec3.hpp>
+#include <nytl/vec2.hpp>
+#include <cstring>
+#include <vector>
+
+TEST(basic) {
+	std::vector<nytl::Vec3f> positions {{1.f, 2.f, 3.f}, {4.f, 5.f, 6.f}};
+	std::vector<nytl::Vec3f> normals {{0.f, 1.f, 0.f}, {1.f, 0.f, 0.f}};
+	std::vector<nytl::Vec2f> uvs {{0.f, 0.f}, {1.f, 1.f}};
+
+	constexpr auto stride =
+		nytl::interleavedStride<nytl::Vec3f, nytl::Vec3f, nytl::Vec2f>();
+	EXPECT(stride, std::size_t(32));
+
+	std::vector<std::byte> data(2 * stride);
+	auto buf = nytl::WriteBuf(data);
+	nytl::interleave(buf,
+		nytl::span<const nytl::Vec3f>(positions),
+		nytl::span<const nytl::Vec3f>(normals),
+		nytl::span<const nytl::Vec2f>(uvs));
+	EXPECT(buf.empty(), true);
+
+	// second vertex: position at offset 32, uv at offset 32 + 24
+	float val;
+	std::memcpy(&val, &data[stride], sizeof(val));
+	EXPECT(val, 4.f);
+	std::memcpy(&val, &data[stride + 24], sizeof(val));
+	EXPECT(val, 1.f);
+}
+
+TEST(roundtrip) {
+	std::vector<nytl::Vec3f> positions(100);
+	std::vector<nytl::Vec2f> uvs(100);
+	for(auto i = 0u; i < positions.size(); ++i) {
+		positions[i] = {float(i), 0.f, -float(i)};
+		uvs[i] = {0.01f * i, 1.f};
+	}
+
+	nytl::DynWriteBuf data;
+	nytl::interleave(data,
+		nytl::span<const nytl::Vec3f>(positions),
+		nytl::span<const nytl::Vec2f>(uvs));
+	EXPECT(data.size(),
+		(nytl::interleavedSize<nytl::Vec3f, nytl::Vec2f>(100)));
+
+	std::vector<nytl::Vec3f> rpos(100);
+	std::vector<nytl::Vec2f> ruvs(100);
+	auto src = nytl::ReadBuf(data);
+	nytl::deinterleave(src,
+		nytl::span<nytl::Vec3f>(rpos),
+		nytl::span<nytl::Vec2f>(ruvs));
+
+	EXPECT(rpos == positions, true);
+	EXPECT(ruvs == uvs, true);
+}
+
+TEST(tuple) {
+	std::vector<float> weights {0.5f, 0.25f};
+	std::vector<std::uint32_t> indices {7u, 9u};
+
+	auto format = std::tuple {
+		nytl::span<const float>(weights),
+		nytl::span<const std::uint32_t>(indices)};
+
+	nytl::DynWriteBuf data;
+	nytl::interleave(data, format);
+	EXPECT(data.size(), std::size_t(16));
+
+	std::uint32_t idx;
+	std::memcpy(&idx, &data[12], sizeof(idx));
+	EXPECT(idx, 9u);
+}
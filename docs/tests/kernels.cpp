@@ -0,0 +1,59 @@
+#include "test.hpp"
+#include <nytl/kernels.hpp>
+#include <vector>
+
+TEST(spans) {
+	std::vector<float> a(100), b(100), out(100);
+	for(auto i = 0u; i < a.size(); ++i) {
+		a[i] = float(i);
+		b[i] = 2.f;
+	}
+
+	nytl::kernels::mulSpan(a.data(), b.data(), out.data(), out.size());
+	EXPECT(out[50], 100.f);
+
+	nytl::kernels::fmaddSpan(a.data(), b.data(), out.data(), out.size());
+	EXPECT(out[50], 200.f);
+
+	std::vector<float> squares {4.f, 9.f, 16.f};
+	nytl::kernels::sqrtSpan(squares.data(), squares.size());
+	EXPECT(squares[2], 4.f);
+}
+
+TEST(transform) {
+	// row-major scale + translate
+	const float mat[16] = {
+		2.f, 0.f, 0.f, 1.f,
+		0.f, 2.f, 0.f, 0.f,
+		0.f, 0.f, 2.f, 0.f,
+		0.f, 0.f, 0.f, 1.f,
+	};
+
+	std::vector<float> src(4 * 10, 1.f);
+	std::vector<float> dst(src.size());
+	nytl::kernels::transform4(mat, src.data(), dst.data(), 10);
+	EXPECT(dst[0], 3.f); // 2 * 1 + 1 * w
+	EXPECT(dst[1], 2.f);
+	EXPECT(dst[4 * 9 + 3], 1.f);
+}
+
+TEST(byteswap) {
+	std::uint16_t v2[] = {0x1234};
+	nytl::kernels::byteswap2(v2, 1);
+	EXPECT(v2[0], std::uint16_t(0x3412));
+
+	std::uint32_t v4[] = {0x12345678u, 0xaabbccddu};
+	nytl::kernels::byteswap4(v4, 2);
+	EXPECT(v4[0], 0x78563412u);
+	EXPECT(v4[1], 0xddccbbaau);
+
+	std::uint64_t v8[] = {0x0102030405060708u};
+	nytl::kernels::byteswap8(v8, 1);
+	EXPECT(v8[0], 0x0807060504030201u);
+}
+
+TEST(charCount) {
+	// 2 ascii + 1 two-byte + 1 four-byte code point
+	const char str[] = "ab\xc3\xa4\xf0\x9f\xa6\x8a";
+	EXPECT(nytl::kernels::charCount8(str, sizeof(str) - 1), std::size_t(4));
+}
@@ -60,6 +60,36 @@ TEST(basic) {
 	// 3 - nytl::mat::transpose(x) * x;
 }
 
+// makes sure the blocked multiplication path (inner dimension > 8)
+// matches the naive definition
+TEST(mult_blocked) {
+	constexpr auto size = 12u;
+	nytl::Mat<size, size, double> a {};
+	nytl::Mat<size, size, double> b {};
+	for(auto r = 0u; r < size; ++r) {
+		for(auto c = 0u; c < size; ++c) {
+			a[r][c] = 1.0 + r * size + c;
+			b[r][c] = (r == c) ? 2.0 : (c > r) ? -1.0 : 0.5;
+		}
+	}
+
+	nytl::Mat<size, size, double> ref {};
+	for(auto r = 0u; r < size; ++r)
+		for(auto c = 0u; c < size; ++c)
+			for(auto i = 0u; i < size; ++i)
+				ref[r][c] += a[r][i] * b[i][c];
+
+	EXPECT(a * b, nytl::approx(ref));
+
+	auto id = nytl::identity<size, double>();
+	EXPECT(a * id, nytl::approx(a));
+	EXPECT(id * b, nytl::approx(b));
+
+	auto aCopy = a;
+	aCopy *= b;
+	EXPECT(aCopy, nytl::approx(ref));
+}
+
 TEST(echolon) {
 	nytl::Mat<3, 5, double> a {
 		2.0, 1.0, -1.0, 8.0, 80.0,
@@ -180,3 +210,108 @@ TEST(inverse) {
 		// ERROR(nytl::inverse(lups), std::invalid_argument);
 	}
 }
+
+TEST(affine_inverse) {
+	// translation * rotation * scale, as produced by transform.hpp
+	auto angle = 0.64;
+	auto c = std::cos(angle);
+	auto s = std::sin(angle);
+	nytl::Mat4d affine {
+		2.0 * c, -2.0 * s, 0.0, 4.0,
+		2.0 * s, 2.0 * c, 0.0, -1.0,
+		0.0, 0.0, 3.0, 2.5,
+		0.0, 0.0, 0.0, 1.0
+	};
+
+	auto inv = nytl::affineInverse(affine);
+	EXPECT(inv, nytl::approx(nytl::inverse(affine), 0.00001));
+
+	nytl::Mat4d id {};
+	nytl::identity(id);
+	EXPECT(affine * inv, nytl::approx(id, 0.00001));
+
+	// rotation + translation only: the rigid variant suffices
+	nytl::Mat4d rigid {
+		c, -s, 0.0, 4.0,
+		s, c, 0.0, -1.0,
+		0.0, 0.0, 1.0, 2.5,
+		0.0, 0.0, 0.0, 1.0
+	};
+
+	EXPECT(nytl::rigidInverse(rigid), nytl::approx(nytl::inverse(rigid), 0.00001));
+	EXPECT(rigid * nytl::rigidInverse(rigid), nytl::approx(id, 0.00001));
+}
+
+TEST(lu_batch) {
+	nytl::Mat3d a {
+		0.0, 2.0, 3.0,
+		1.0, 1.0, -2.0,
+		5.0, -2.0, 1.0
+	};
+
+	auto lu = nytl::luDecomp(a);
+
+	std::array<nytl::Vec3d, 4> b {{
+		{1.0, 2.0, 3.0},
+		{0.0, 0.0, 0.0},
+		{-4.0, 1.5, 10.0},
+		{100.0, -20.0, 3.3}
+	}};
+
+	// span-of-vectors batch matches the single-vector solves
+	std::array<nytl::Vec3d, 4> x {};
+	nytl::luEvaluate(lu, nytl::span<const nytl::Vec3d>(b),
+		nytl::span<nytl::Vec3d>(x));
+	for(auto n = 0u; n < b.size(); ++n) {
+		EXPECT(x[n], nytl::approx(nytl::luEvaluate(lu, b[n]), 0.00001));
+		EXPECT(a * x[n], nytl::approx(b[n], 0.00001));
+	}
+
+	// matrix of stacked columns
+	nytl::Mat<3, 4, double> bm {};
+	for(auto n = 0u; n < 4u; ++n) {
+		nytl::col(bm, n, b[n]);
+	}
+
+	auto xm = nytl::luEvaluate(lu, bm);
+	for(auto n = 0u; n < 4u; ++n) {
+		EXPECT(nytl::col(xm, n), nytl::approx(x[n], 0.00001));
+	}
+}
+
+TEST(cholesky) {
+	// symmetric positive-definite matrix
+	nytl::Mat3d a {
+		4.0, 12.0, -16.0,
+		12.0, 37.0, -43.0,
+		-16.0, -43.0, 98.0
+	};
+
+	EXPECT(nytl::symmetric(a), true);
+
+	auto chol = nytl::choleskyDecomp(a);
+	nytl::Mat3d expected {
+		2.0, 0.0, 0.0,
+		6.0, 1.0, 0.0,
+		-8.0, 5.0, 3.0
+	};
+
+	EXPECT(chol.lower, nytl::approx(expected, 0.00001));
+	EXPECT(chol.lower * nytl::transpose(chol.lower), nytl::approx(a, 0.00001));
+
+	EXPECT(nytl::determinant(chol), nytl::approx(nytl::determinant(a), 0.00001));
+	EXPECT(nytl::inverse(chol), nytl::approx(nytl::inverse(a), 0.00001));
+
+	nytl::Vec3d b {1.0, 2.0, 3.0};
+	auto x = nytl::choleskySolve(chol, b);
+	EXPECT(a * x, nytl::approx(b, 0.00001));
+	EXPECT(x, nytl::approx(nytl::luEvaluate(nytl::luDecomp(a), b), 0.00001));
+}
+
+TEST(format) {
+	char buf[64];
+	auto mat = nytl::Mat2i {1, 2, 3, 4};
+	auto len = nytl::format(buf, mat);
+	EXPECT(std::string(buf, len), std::string("{(1, 2), (3, 4)}"));
+	EXPECT(nytl::format(nytl::span<char>(buf, 8), mat), 0u);
+}
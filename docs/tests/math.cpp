@@ -0,0 +1,43 @@
+#include "test.hpp"
+#include <nytl/math.hpp>
+#include <cmath>
+
+TEST(sinCos) {
+	// exact at the special points
+	EXPECT(nytl::fastSin(0.0), 0.0);
+	EXPECT(nytl::fastCos(0.0), 1.0);
+
+	// matches libm within the documented bound
+	for(auto i = -1000; i <= 1000; ++i) {
+		auto x = 0.05 * i;
+		EXPECT(std::fabs(nytl::fastSin(x) - std::sin(x)) < 2e-9, true);
+		EXPECT(std::fabs(nytl::fastCos(x) - std::cos(x)) < 2e-9, true);
+	}
+
+	auto [sin, cos] = nytl::fastSinCos(1.0);
+	EXPECT(std::fabs(sin - std::sin(1.0)) < 2e-9, true);
+	EXPECT(std::fabs(cos - std::cos(1.0)) < 2e-9, true);
+
+	// usable in constant expressions
+	constexpr auto sc = nytl::fastSinCos(nytl::radians(90.0));
+	static_assert(sc.sin > 0.999999999);
+}
+
+TEST(atan2) {
+	EXPECT(nytl::fastAtan2(0.0, 0.0), 0.0);
+	EXPECT(nytl::fastAtan2(0.0, 1.0), 0.0);
+
+	for(auto i = -50; i <= 50; ++i) {
+		for(auto j = -50; j <= 50; ++j) {
+			if(!i && !j) {
+				continue;
+			}
+
+			auto diff = nytl::fastAtan2(0.1 * i, 0.1 * j)
+				- std::atan2(0.1 * i, 0.1 * j);
+			EXPECT(std::fabs(diff) < 3e-9, true);
+		}
+	}
+
+	static_assert(nytl::fastAtan2(1.0, 1.0) > 0.0);
+}
@@ -0,0 +1,88 @@
+#include "test.hpp"
+#include <nytl/mmapBuf.hpp>
+#include <cstdio>
+#include <fstream>
+
+namespace {
+
+void writeFile(const char* path, nytl::ReadBuf data) {
+	std::ofstream out(path, std::ios::binary);
+	out.write(reinterpret_cast<const char*>(data.data()), data.size());
+}
+
+} // anon namespace
+
+TEST(map) {
+	// write a small data segment to a temporary file
+	auto path = "nytl-test-mmap.bin";
+	nytl::DynWriteBuf data;
+	nytl::write(data, 1.f);
+	nytl::write(data, 42u);
+	nytl::write<std::uint8_t>(data, 7u);
+	writeFile(path, data);
+
+	// map it back and deserialize directly from the mapping
+	{
+		nytl::MmapReadBuf map(path);
+		EXPECT(map.mapped(), true);
+		EXPECT(map.size(), data.size());
+
+		nytl::ReadBuf buf = map;
+		EXPECT(nytl::read<float>(buf), 1.f);
+		EXPECT(nytl::read<unsigned>(buf), 42u);
+		nytl::skip(buf, 1);
+		EXPECT(buf.empty(), true);
+
+		// move semantics
+		auto map2 = std::move(map);
+		EXPECT(map.mapped(), false);
+		EXPECT(map2.size(), data.size());
+	}
+
+	std::remove(path);
+}
+
+TEST(access) {
+	// all access patterns map readably, advise may be changed later
+	auto path = "nytl-test-mmap-access.bin";
+	nytl::DynWriteBuf data;
+	nytl::write(data, 1337u);
+	writeFile(path, data);
+
+	using Access = nytl::MmapReadBuf::Access;
+	for(auto access : {Access::normal, Access::sequential, Access::random}) {
+		nytl::MmapReadBuf map(path, access);
+		nytl::ReadBuf buf = map;
+		EXPECT(nytl::read<unsigned>(buf), 1337u);
+
+		map.advise(Access::random);
+		buf = map;
+		EXPECT(nytl::read<unsigned>(buf), 1337u);
+	}
+
+	std::remove(path);
+}
+
+TEST(empty) {
+	// an empty file needs no mapping but is not an error
+	auto path = "nytl-test-mmap-empty.bin";
+	writeFile(path, {});
+
+	nytl::MmapReadBuf map(path);
+	EXPECT(map.mapped(), false);
+	EXPECT(map.size(), std::size_t(0));
+	EXPECT(map.buf().empty(), true);
+	map.advise(nytl::MmapReadBuf::Access::random); // no-op, must not crash
+
+	std::remove(path);
+}
+
+TEST(errors) {
+	ERROR(nytl::MmapReadBuf("nytl-test-does-not-exist.bin"),
+		std::system_error);
+
+	// a default-constructed buf is simply unmapped
+	nytl::MmapReadBuf map;
+	EXPECT(map.mapped(), false);
+	EXPECT(map.buf().empty(), true);
+}
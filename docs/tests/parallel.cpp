@@ -0,0 +1,69 @@
+#include "test.hpp"
+#include <nytl/parallel.hpp>
+#include <nytl/approx.hpp>
+#include <nytl/vecOps.hpp>
+#include <nytl/vec3.hpp>
+#include <atomic>
+#include <numeric>
+#include <vector>
+
+TEST(forEach) {
+	std::vector<int> values(100000);
+	std::iota(values.begin(), values.end(), 0);
+
+	std::atomic<std::uint64_t> visited {0};
+	nytl::parallelFor(nytl::span<int>(values), [&](int& val) {
+		val += 1;
+		visited.fetch_add(1, std::memory_order_relaxed);
+	});
+
+	EXPECT(visited.load(), std::uint64_t(100000));
+	EXPECT(values.front(), 1);
+	EXPECT(values.back(), 100000);
+}
+
+TEST(transform) {
+	std::vector<nytl::Vec3f> src(5000, nytl::Vec3f {3.f, 0.f, 4.f});
+	std::vector<float> dst(src.size());
+
+	nytl::parallelTransform(nytl::span<const nytl::Vec3f>(src),
+		nytl::span<float>(dst),
+		[](const nytl::Vec3f& vec) { return nytl::length(vec); });
+
+	for(auto& len : dst) {
+		EXPECT(len, nytl::approx(5.f));
+	}
+}
+
+TEST(reduce) {
+	std::vector<std::uint64_t> values(200000, 1u);
+	values[177] = 43u;
+
+	auto sum = nytl::parallelReduce(nytl::span<const std::uint64_t>(values),
+		std::uint64_t(0),
+		[](nytl::span<const std::uint64_t> chunk, std::uint64_t acc) {
+			for(auto& val : chunk) {
+				acc += val;
+			}
+
+			return acc;
+		}, [](std::uint64_t a, std::uint64_t b) { return a + b; });
+
+	EXPECT(sum, std::uint64_t(200042));
+}
+
+TEST(nested) {
+	std::vector<int> outer(64, 0);
+	std::atomic<int> total {0};
+
+	// inner calls must fall back to serial execution instead of
+	// deadlocking on the busy pool
+	nytl::parallelFor(nytl::span<int>(outer), [&](int&) {
+		std::vector<int> inner(32, 1);
+		nytl::parallelFor(nytl::span<int>(inner), [&](int& val) {
+			total.fetch_add(val, std::memory_order_relaxed);
+		}, 4);
+	}, 1);
+
+	EXPECT(total.load(), 64 * 32);
+}
@@ -0,0 +1,63 @@
+#include "test.hpp"
+#include <nytl/profile.hpp>
+#include <sstream>
+#include <thread>
+
+namespace {
+
+void inner() {
+	NYTL_PROFILE_SCOPE("inner");
+	NYTL_PROFILE_COUNTER("calls", 1);
+	std::this_thread::sleep_for(std::chrono::milliseconds(1));
+}
+
+void outer() {
+	NYTL_PROFILE_SCOPE("outer");
+	inner();
+	inner();
+}
+
+// two scopes in the same block must get distinct timer names
+// (regression: the macro once pasted the literal token __LINE__)
+void twice() {
+	NYTL_PROFILE_SCOPE("first");
+	NYTL_PROFILE_SCOPE("second");
+}
+
+} // anon namespace
+
+TEST(scopes) {
+	outer();
+	outer();
+	twice();
+
+	std::ostringstream os;
+	nytl::profile::dump(os);
+	auto str = os.str();
+
+	EXPECT(str.find("outer ") != std::string::npos, true);
+	EXPECT(str.find("outer;inner ") != std::string::npos, true);
+	EXPECT(str.find("# calls 4") != std::string::npos, true);
+
+	// inner was entered 4 times, its self time must be at least the
+	// slept 4ms while outer only accounts for its own self time
+	auto pos = str.find("outer;inner ");
+	std::uint64_t self, count;
+	std::istringstream(str.substr(pos + 12)) >> self >> count;
+	EXPECT(count, 4u);
+	EXPECT(self >= 4 * 1000 * 1000, true);
+}
+
+TEST(otherThread) {
+	auto thread = std::thread([]{
+		NYTL_PROFILE_SCOPE("worker");
+		NYTL_PROFILE_COUNTER("workerItems", 7);
+	});
+	thread.join();
+
+	// the worker's buffer was unregistered on thread exit, its
+	// events must no longer show up
+	std::ostringstream os;
+	nytl::profile::dump(os);
+	EXPECT(os.str().find("worker") == std::string::npos, true);
+}
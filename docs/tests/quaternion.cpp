@@ -0,0 +1,96 @@
+#include "test.hpp"
+#include <nytl/quaternion.hpp>
+#include <nytl/approxVec.hpp>
+#include <array>
+
+// approx comparison for quaternions
+bool near(const nytl::Quaternion& a, const nytl::Quaternion& b, double eps = 0.00001) {
+	return std::abs(a.x - b.x) < eps && std::abs(a.y - b.y) < eps &&
+		std::abs(a.z - b.z) < eps && std::abs(a.w - b.w) < eps;
+}
+
+TEST(basic) {
+	auto q = nytl::Quaternion::axisAngle(0, 1, 0, 0.5 * M_PI);
+	EXPECT(nytl::norm(q), nytl::approx(1.0));
+	EXPECT(nytl::dot(q, q), nytl::approx(1.0));
+
+	auto v = nytl::apply(q, nytl::Vec3d {1.0, 0.0, 0.0});
+	EXPECT(v, nytl::approx(nytl::Vec3d {0.0, 0.0, -1.0}, 0.00001));
+}
+
+TEST(interpolation) {
+	auto a = nytl::Quaternion::axisAngle(0, 1, 0, 0.2);
+	auto b = nytl::Quaternion::axisAngle(0, 1, 0, 1.0);
+
+	// slerp with t=0.5 lands at the half-angle rotation
+	auto mid = nytl::Quaternion::axisAngle(0, 1, 0, 0.6);
+	EXPECT(near(nytl::normalized(nytl::slerp(a, b, 0.5)), mid), true);
+
+	// endpoints
+	EXPECT(near(nytl::normalized(nytl::slerp(a, b, 0.0)), a), true);
+	EXPECT(near(nytl::normalized(nytl::slerp(a, b, 1.0)), b), true);
+	EXPECT(near(nytl::nlerp(a, b, 0.0), a), true);
+	EXPECT(near(nytl::nlerp(a, b, 1.0), b), true);
+
+	// nlerp approximates slerp for small angles
+	auto c = nytl::Quaternion::axisAngle(0, 1, 0, 0.25);
+	EXPECT(near(nytl::nlerp(a, c, 0.5), nytl::normalized(nytl::slerp(a, c, 0.5)), 0.0001), true);
+
+	// shortest path: interpolating towards -b is the same rotation
+	auto negb = -1.0 * b;
+	auto r1 = nytl::nlerp(a, b, 0.3);
+	auto r2 = nytl::nlerp(a, negb, 0.3);
+	EXPECT(near(r1, r2, 0.0001) || near(r1, -1.0 * r2, 0.0001), true);
+}
+
+TEST(batch) {
+	constexpr auto count = 64u;
+	std::array<nytl::Quaternion, count> a, b, out;
+	std::array<double, count> t;
+	for(auto i = 0u; i < count; ++i) {
+		a[i] = nytl::Quaternion::axisAngle(0, 1, 0, 0.01 * i);
+		b[i] = nytl::Quaternion::axisAngle(1, 0, 0, 0.02 * i);
+		t[i] = i / double(count);
+	}
+
+	// shared t batches match the single-pair kernels
+	nytl::slerp(a, b, 0.25, out);
+	for(auto i = 0u; i < count; ++i) {
+		EXPECT(near(out[i], nytl::slerp(a[i], b[i], 0.25)), true);
+	}
+
+	nytl::nlerp(a, b, 0.25, out);
+	for(auto i = 0u; i < count; ++i) {
+		EXPECT(near(out[i], nytl::nlerp(a[i], b[i], 0.25)), true);
+	}
+
+	// per-element t
+	nytl::slerp(a, b, t, out);
+	for(auto i = 0u; i < count; ++i) {
+		EXPECT(near(out[i], nytl::slerp(a[i], b[i], t[i])), true);
+	}
+
+	nytl::nlerp(a, b, t, out);
+	for(auto i = 0u; i < count; ++i) {
+		EXPECT(near(out[i], nytl::nlerp(a[i], b[i], t[i])), true);
+	}
+}
+
+TEST(squad) {
+	// keyframes along the y axis
+	auto q0 = nytl::Quaternion::axisAngle(0, 1, 0, 0.0);
+	auto q1 = nytl::Quaternion::axisAngle(0, 1, 0, 0.4);
+	auto q2 = nytl::Quaternion::axisAngle(0, 1, 0, 0.8);
+	auto q3 = nytl::Quaternion::axisAngle(0, 1, 0, 1.2);
+
+	auto a = nytl::squadControl(q0, q1, q2);
+	auto b = nytl::squadControl(q1, q2, q3);
+
+	// endpoints are hit exactly
+	EXPECT(near(nytl::normalized(nytl::squad(q1, a, b, q2, 0.0)), q1), true);
+	EXPECT(near(nytl::normalized(nytl::squad(q1, a, b, q2, 1.0)), q2), true);
+
+	// for a uniform single-axis spin, squad degenerates to slerp
+	auto s = nytl::normalized(nytl::squad(q1, a, b, q2, 0.5));
+	EXPECT(near(s, nytl::normalized(nytl::slerp(q1, q2, 0.5)), 0.001), true);
+}
@@ -1,6 +1,7 @@
 #include "test.hpp"
 #include <nytl/recursiveCallback.hpp>
 #include <nytl/tmpUtil.hpp>
+#include <memory_resource>
 
 // TODO: simple tests that varify the semantics of mixing/recursing
 // operations. Also test with custom id type
@@ -300,3 +301,21 @@ TEST(connection) {
 	cb();
 	EXPECT(called, 7u);
 }
+
+TEST(memory_resource) {
+	// subscriptions allocated from a local arena
+	std::pmr::unsynchronized_pool_resource pool;
+	nytl::RecursiveCallback<unsigned()> cb(&pool);
+
+	for(auto i = 0u; i < 100; ++i) {
+		cb.add([i]{ return i; });
+	}
+
+	auto ret = cb();
+	EXPECT(ret.size(), 100u);
+	EXPECT(ret[42], 42u);
+
+	auto conn = cb.add([]{ return 1000u; });
+	conn.disconnect();
+	EXPECT(cb().size(), 100u);
+}
@@ -78,3 +78,55 @@ TEST(rect) {
 		EXPECT(valid, true);
 	}
 }
+
+TEST(batch) {
+	nytl::Rect2f damage {{2.f, 2.f}, {4.f, 4.f}};
+	std::array<nytl::Rect2f, 5> windows {{
+		{{0.f, 0.f}, {1.f, 1.f}}, // disjoint
+		{{1.f, 1.f}, {2.f, 2.f}}, // overlaps
+		{{3.f, 3.f}, {1.f, 1.f}}, // inside
+		{{6.f, 2.f}, {2.f, 2.f}}, // touches
+		{{7.f, 7.f}, {1.f, 1.f}} // disjoint
+	}};
+
+	auto rects = nytl::span<const nytl::Rect2f>(windows);
+	EXPECT(nytl::intersectsAny(damage, rects), true);
+	EXPECT(nytl::intersectsAll(damage, rects), false);
+
+	std::array<std::uint64_t, 1> mask {};
+	nytl::intersectsMask(damage, rects, mask);
+	EXPECT(mask[0], 0b01110u);
+
+	// results match the scalar predicate
+	for(auto i = 0u; i < windows.size(); ++i) {
+		auto bit = (mask[0] >> i) & 1;
+		EXPECT(bit != 0, nytl::intersects(damage, windows[i]));
+	}
+
+	// planar pack gives the same mask
+	nytl::RectPack<2, float> pack(rects);
+	EXPECT(pack.size(), windows.size());
+	std::array<std::uint64_t, 1> planarMask {};
+	nytl::intersectsMask(damage, pack, planarMask);
+	EXPECT(planarMask[0], mask[0]);
+
+	// oversized masks get their unused words zeroed, like the
+	// scalar overload
+	std::array<std::uint64_t, 3> oversized {~std::uint64_t(0),
+		~std::uint64_t(0), ~std::uint64_t(0)};
+	nytl::intersectsMask(damage, pack, oversized);
+	EXPECT(oversized[0], mask[0]);
+	EXPECT(oversized[1], std::uint64_t(0));
+	EXPECT(oversized[2], std::uint64_t(0));
+
+	nytl::containsMask(damage, rects, mask);
+	EXPECT(mask[0], 0b00100u);
+}
+
+TEST(format) {
+	char buf[64];
+	auto rect = nytl::Rect2i {{1, 2}, {3, 4}};
+	auto len = nytl::format(buf, rect);
+	EXPECT(std::string(buf, len), std::string("{(1, 2)(3, 4)}"));
+	EXPECT(nytl::format(nytl::span<char>(buf, 8), rect), 0u);
+}
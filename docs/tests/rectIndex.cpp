@@ -0,0 +1,84 @@
+#include "test.hpp"
+#include <nytl/rectIndex.hpp>
+#include <array>
+#include <random>
+#include <vector>
+
+TEST(basic) {
+	std::array<nytl::Rect2f, 4> rects {{
+		{{0.f, 0.f}, {10.f, 10.f}},
+		{{20.f, 0.f}, {10.f, 10.f}},
+		{{0.f, 20.f}, {10.f, 10.f}},
+		{{5.f, 5.f}, {30.f, 30.f}}
+	}};
+
+	nytl::RectIndex2f index{nytl::span<const nytl::Rect2f>(rects)};
+	EXPECT(index.size(), 4u);
+
+	std::array<std::uint32_t, 8> out;
+	auto n = index.query(nytl::Vec2f {2.f, 2.f}, out);
+	EXPECT(n, 1u);
+	EXPECT(out[0], 0u);
+
+	n = index.query(nytl::Vec2f {7.f, 7.f}, out);
+	EXPECT(n, 2u);
+
+	n = index.query(nytl::Vec2f {100.f, 100.f}, out);
+	EXPECT(n, 0u);
+
+	n = index.query(nytl::Rect2f {{19.f, 1.f}, {2.f, 2.f}}, out);
+	EXPECT(n, 1u);
+	EXPECT(out[0], 1u);
+
+	n = index.query(nytl::Rect2f {{8.f, 8.f}, {20.f, 20.f}}, out);
+	EXPECT(n, 4u); // reaches into every rect
+	EXPECT(index.any({{19.f, 1.f}, {2.f, 2.f}}), true);
+	EXPECT(index.any({{50.f, 50.f}, {1.f, 1.f}}), false);
+}
+
+TEST(stress) {
+	// compare against a linear scan over many random windows
+	std::mt19937 rng(42);
+	std::uniform_real_distribution<float> pos(0.f, 1000.f);
+	std::uniform_real_distribution<float> size(1.f, 50.f);
+
+	std::vector<nytl::Rect2f> rects(2000);
+	for(auto& r : rects) {
+		r = {{pos(rng), pos(rng)}, {size(rng), size(rng)}};
+	}
+
+	nytl::RectIndex2f index{rects};
+
+	std::vector<std::uint32_t> out(rects.size());
+	for(auto q = 0u; q < 100; ++q) {
+		nytl::Rect2f area {{pos(rng), pos(rng)}, {size(rng), size(rng)}};
+
+		auto expected = 0u;
+		for(auto& r : rects) {
+			if(nytl::intersects(r, area)) {
+				++expected;
+			}
+		}
+
+		EXPECT(index.query(area, out), expected);
+
+		auto point = nytl::Vec2f {pos(rng), pos(rng)};
+		expected = 0u;
+		for(auto& r : rects) {
+			if(nytl::contains(r, point)) {
+				++expected;
+			}
+		}
+
+		EXPECT(index.query(point, out), expected);
+	}
+}
+
+TEST(capacity) {
+	// matches beyond the output buffer are counted but dropped
+	std::vector<nytl::Rect2f> rects(10, {{0.f, 0.f}, {1.f, 1.f}});
+	nytl::RectIndex2f index{rects};
+
+	std::array<std::uint32_t, 4> out;
+	EXPECT(index.query(nytl::Vec2f {0.5f, 0.5f}, out), 10u);
+}
@@ -0,0 +1,73 @@
+#include "test.hpp"
+#include <nytl/region.hpp>
+
+TEST(basic) {
+	nytl::RegionI region;
+	EXPECT(region.empty(), true);
+
+	region.add({{0, 0}, {10, 10}});
+	EXPECT(region.size(), 1u);
+	EXPECT(region.area(), 100);
+	EXPECT(region.contains({5, 5}), true);
+	EXPECT(region.contains({15, 5}), false);
+
+	// adding a covered rect changes nothing
+	region.add({{2, 2}, {4, 4}});
+	EXPECT(region.size(), 1u);
+	EXPECT(region.area(), 100);
+
+	// union with an overlapping rect only adds the uncovered area
+	region.add({{5, 0}, {10, 10}});
+	EXPECT(region.area(), 150);
+	EXPECT((region.bounds() == nytl::Rect2i {{0, 0}, {15, 10}}), true);
+	EXPECT(region.contains({12, 5}), true);
+}
+
+TEST(subtract) {
+	nytl::RegionI region({{0, 0}, {10, 10}});
+
+	// punching a hole in the middle splits into 4 pieces
+	region.subtract({{4, 4}, {2, 2}});
+	EXPECT(region.area(), 96);
+	EXPECT(region.contains({5, 5}), false);
+	EXPECT(region.contains({1, 5}), true);
+	EXPECT(region.contains({5, 1}), true);
+
+	// subtracting everything empties the region
+	region.subtract({{0, 0}, {10, 10}});
+	EXPECT(region.empty(), true);
+	EXPECT(region.area(), 0);
+}
+
+TEST(intersect) {
+	nytl::RegionI region;
+	region.add({{0, 0}, {10, 10}});
+	region.add({{20, 0}, {10, 10}});
+	EXPECT(region.area(), 200);
+
+	region.intersect({{5, 5}, {20, 10}});
+	EXPECT(region.area(), 25 + 25);
+	EXPECT(region.contains({6, 6}), true);
+	EXPECT(region.contains({1, 1}), false);
+	EXPECT(region.intersects({{0, 0}, {6, 6}}), true);
+	EXPECT(region.intersects({{0, 0}, {4, 4}}), false);
+}
+
+TEST(bands) {
+	// rects in the same band that become adjacent get merged
+	nytl::RegionI region;
+	region.add({{0, 0}, {5, 5}});
+	region.add({{5, 0}, {5, 5}});
+	EXPECT(region.size(), 1u);
+	EXPECT((region.rects()[0] == nytl::Rect2i {{0, 0}, {10, 5}}), true);
+
+	// growing past the inline capacity spills to the heap correctly
+	for(auto i = 0; i < 20; ++i) {
+		region.add({{2 * i, 10}, {1, 1}});
+	}
+
+	EXPECT(region.size(), 21u);
+	EXPECT(region.area(), 50 + 20);
+	EXPECT(region.contains({38, 10}), true);
+	EXPECT(region.contains({40, 10}), false);
+}
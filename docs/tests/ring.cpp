@@ -0,0 +1,96 @@
+#include "test.hpp"
+#include <nytl/ring.hpp>
+#include <memory>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+TEST(basic) {
+	nytl::RingBuffer<int> ring(3); // rounded up
+	EXPECT(ring.capacity(), 4u);
+	EXPECT(ring.empty(), true);
+
+	EXPECT(ring.tryPush(1), true);
+	EXPECT(ring.tryPush(2), true);
+	EXPECT(ring.tryPush(3), true);
+	EXPECT(ring.tryPush(4), true);
+	EXPECT(ring.tryPush(5), false); // full
+	EXPECT(ring.size(), 4u);
+
+	auto v = 0;
+	EXPECT(ring.tryPop(v), true);
+	EXPECT(v, 1);
+	EXPECT(ring.tryPush(5), true);
+
+	for(auto expected = 2; expected <= 5; ++expected) {
+		EXPECT(ring.tryPop(v), true);
+		EXPECT(v, expected);
+	}
+
+	EXPECT(ring.tryPop(v), false); // empty
+	EXPECT(ring.empty(), true);
+}
+
+TEST(bulk) {
+	nytl::RingBuffer<int> ring(8);
+	std::vector<int> values(12);
+	std::iota(values.begin(), values.end(), 0);
+
+	// only the fitting prefix is pushed
+	EXPECT(ring.push(nytl::span<const int>(values)), 8u);
+	EXPECT(ring.size(), 8u);
+
+	std::vector<int> out(5);
+	EXPECT(ring.pop(nytl::span<int>(out)), 5u);
+	EXPECT(out, (std::vector {0, 1, 2, 3, 4}));
+
+	// wraps around the buffer end
+	EXPECT(ring.push(nytl::span<const int>(values.data() + 8, 4)), 4u);
+	out.resize(8);
+	EXPECT(ring.pop(nytl::span<int>(out)), 7u);
+	EXPECT(out[0], 5);
+	EXPECT(out[6], 11);
+	EXPECT(ring.pop(nytl::span<int>(out)), 0u);
+}
+
+TEST(nonTrivial) {
+	// move-only values are moved through, leftovers destroyed
+	nytl::RingBuffer<std::shared_ptr<int>> ring(4);
+	auto value = std::make_shared<int>(7);
+	EXPECT(ring.tryPush(value), true);
+	EXPECT(ring.tryPush(value), true);
+
+	std::shared_ptr<int> out;
+	EXPECT(ring.tryPop(out), true);
+	EXPECT(*out, 7);
+	EXPECT(value.use_count(), 3l); // value, out, one in the ring
+	// the remaining element is released by the destructor
+}
+
+TEST(threaded) {
+	constexpr auto count = 100000;
+	nytl::RingBuffer<int> ring(64);
+
+	std::thread producer([&]{
+		for(auto i = 0; i < count;) {
+			if(ring.tryPush(i)) {
+				++i;
+			}
+		}
+	});
+
+	auto ordered = true;
+	auto next = 0;
+	std::vector<int> buf(17);
+	while(next < count) {
+		auto got = ring.pop(nytl::span<int>(buf));
+		for(auto i = 0u; i < got; ++i) {
+			ordered &= (buf[i] == next++);
+		}
+	}
+
+	producer.join();
+	EXPECT(ordered, true);
+	EXPECT(next, count);
+	EXPECT(ring.empty(), true);
+}
@@ -0,0 +1,153 @@
+#include "test.hpp"
+#include <nytl/simplexOps.hpp>
+#include <nytl/approxVec.hpp>
+#include <array>
+#include <vector>
+
+TEST(triangle) {
+	nytl::Simplex<2, double, 2> tri {{{
+		{0.0, 0.0}, {4.0, 0.0}, {0.0, 4.0}
+	}}};
+
+	// corners map to the unit coordinates
+	EXPECT(nytl::barycentric(tri, {0.0, 0.0}), nytl::approx(nytl::Vec3d {1.0, 0.0, 0.0}));
+	EXPECT(nytl::barycentric(tri, {4.0, 0.0}), nytl::approx(nytl::Vec3d {0.0, 1.0, 0.0}));
+	EXPECT(nytl::barycentric(tri, {0.0, 4.0}), nytl::approx(nytl::Vec3d {0.0, 0.0, 1.0}));
+
+	// centroid
+	auto c = nytl::barycentric(tri, {4.0 / 3.0, 4.0 / 3.0});
+	EXPECT(c, nytl::approx(nytl::Vec3d {1.0 / 3.0, 1.0 / 3.0, 1.0 / 3.0}, 0.00001));
+
+	EXPECT(nytl::contains(tri, {1.0, 1.0}), true);
+	EXPECT(nytl::contains(tri, {2.0, 2.0}), true); // on the diagonal
+	EXPECT(nytl::contains(tri, {3.0, 3.0}), false);
+	EXPECT(nytl::contains(tri, {-0.1, 0.0}), false);
+
+	// a triangle in 3d space: the point is projected onto its plane
+	nytl::Simplex<3, double, 2> tri3 {{{
+		{0.0, 0.0, 1.0}, {2.0, 0.0, 1.0}, {0.0, 2.0, 1.0}
+	}}};
+	auto b3 = nytl::barycentric(tri3, {0.5, 0.5, 1.0});
+	EXPECT(b3, nytl::approx(nytl::Vec3d {0.5, 0.25, 0.25}, 0.00001));
+}
+
+TEST(tetrahedron) {
+	nytl::Simplex<3, double, 3> tet {{{
+		{0.0, 0.0, 0.0}, {1.0, 0.0, 0.0}, {0.0, 1.0, 0.0}, {0.0, 0.0, 1.0}
+	}}};
+
+	EXPECT(nytl::barycentric(tet, {0.0, 0.0, 0.0}),
+		nytl::approx(nytl::Vec4d {1.0, 0.0, 0.0, 0.0}));
+	EXPECT(nytl::barycentric(tet, {0.0, 0.0, 1.0}),
+		nytl::approx(nytl::Vec4d {0.0, 0.0, 0.0, 1.0}));
+	EXPECT(nytl::barycentric(tet, {0.25, 0.25, 0.25}),
+		nytl::approx(nytl::Vec4d {0.25, 0.25, 0.25, 0.25}, 0.00001));
+
+	EXPECT(nytl::contains(tet, {0.1, 0.1, 0.1}), true);
+	EXPECT(nytl::contains(tet, {0.5, 0.5, 0.5}), false);
+}
+
+TEST(batch) {
+	nytl::Simplex<2, float, 2> tri {{{
+		{0.f, 0.f}, {4.f, 0.f}, {0.f, 4.f}
+	}}};
+
+	std::array<nytl::Vec2f, 6> points {{
+		{1.f, 1.f}, // inside
+		{2.f, 2.f}, // on the diagonal
+		{3.f, 3.f}, // outside
+		{0.f, 0.f}, // corner
+		{-1.f, 0.f}, // outside
+		{1.f, 0.f} // on an edge
+	}};
+
+	std::array<std::uint64_t, 1> mask {};
+	nytl::containsMask(tri, nytl::span<const nytl::Vec2f>(points), mask);
+	EXPECT(mask[0], 0b101011u);
+
+	// winding independent: flipping two corners changes nothing
+	std::swap(tri.points()[0], tri.points()[1]);
+	nytl::containsMask(tri, nytl::span<const nytl::Vec2f>(points), mask);
+	EXPECT(mask[0], 0b101011u);
+}
+
+TEST(closest) {
+	nytl::Simplex<2, double, 2> tri {{{
+		{0.0, 0.0}, {4.0, 0.0}, {0.0, 4.0}
+	}}};
+
+	// contained points are their own closest point
+	EXPECT(nytl::closestPoint(tri, {1.0, 1.0}),
+		nytl::approx(nytl::Vec2d {1.0, 1.0}));
+	EXPECT(nytl::distanceSq(tri, {1.0, 1.0}), nytl::approx(0.0));
+
+	// vertex, edge and face regions
+	EXPECT(nytl::closestPoint(tri, {-1.0, -2.0}),
+		nytl::approx(nytl::Vec2d {0.0, 0.0}));
+	EXPECT(nytl::closestPoint(tri, {2.0, -3.0}),
+		nytl::approx(nytl::Vec2d {2.0, 0.0}));
+	EXPECT(nytl::closestPoint(tri, {4.0, 4.0}),
+		nytl::approx(nytl::Vec2d {2.0, 2.0}));
+	EXPECT(nytl::distanceSq(tri, {4.0, 4.0}), nytl::approx(8.0));
+
+	// segment: projection clamped to the end points
+	nytl::Simplex<2, double, 1> line {{{{0.0, 0.0}, {2.0, 0.0}}}};
+	EXPECT(nytl::closestPoint(line, {1.0, 3.0}),
+		nytl::approx(nytl::Vec2d {1.0, 0.0}));
+	EXPECT(nytl::closestPoint(line, {5.0, 1.0}),
+		nytl::approx(nytl::Vec2d {2.0, 0.0}));
+
+	// tetrahedron: inside point unchanged, outside projected
+	nytl::Simplex<3, double, 3> tet {{{
+		{0.0, 0.0, 0.0}, {2.0, 0.0, 0.0}, {0.0, 2.0, 0.0}, {0.0, 0.0, 2.0}
+	}}};
+	EXPECT(nytl::closestPoint(tet, {0.25, 0.25, 0.25}),
+		nytl::approx(nytl::Vec3d {0.25, 0.25, 0.25}));
+	EXPECT(nytl::closestPoint(tet, {1.0, 1.0, -2.0}),
+		nytl::approx(nytl::Vec3d {1.0, 1.0, 0.0}));
+	EXPECT(nytl::closestPoint(tet, {-3.0, -3.0, -3.0}),
+		nytl::approx(nytl::Vec3d {0.0, 0.0, 0.0}));
+	EXPECT(nytl::distanceSq(tet, {1.0, 1.0, -2.0}), nytl::approx(4.0));
+}
+
+TEST(closestBatch) {
+	// batch results match the scalar queries
+	nytl::Simplex<2, double, 2> tri {{{
+		{0.0, 0.0}, {4.0, 0.0}, {0.0, 4.0}
+	}}};
+	std::vector<nytl::Vec2d> points;
+	for(auto x = -2.0; x <= 6.0; x += 1.0) {
+		for(auto y = -2.0; y <= 6.0; y += 1.0) {
+			points.push_back({x, y});
+		}
+	}
+
+	std::vector<nytl::Vec2d> out(points.size());
+	nytl::closestPoints(tri, nytl::span<const nytl::Vec2d>(points),
+		nytl::span<nytl::Vec2d>(out));
+	for(auto i = 0u; i < points.size(); ++i) {
+		EXPECT(out[i], nytl::approx(nytl::closestPoint(tri, points[i])));
+	}
+
+	nytl::Simplex<3, double, 3> tet {{{
+		{0.0, 0.0, 0.0}, {2.0, 0.0, 0.0}, {0.0, 2.0, 0.0}, {0.0, 0.0, 2.0}
+	}}};
+	std::vector<nytl::Vec3d> points3;
+	for(auto x = -1.0; x <= 3.0; x += 0.5) {
+		for(auto y = -1.0; y <= 3.0; y += 0.5) {
+			for(auto z = -1.0; z <= 3.0; z += 0.5) {
+				points3.push_back({x, y, z});
+			}
+		}
+	}
+
+	std::vector<nytl::Vec3d> out3(points3.size());
+	nytl::closestPoints(tet, nytl::span<const nytl::Vec3d>(points3),
+		nytl::span<nytl::Vec3d>(out3));
+	for(auto i = 0u; i < points3.size(); ++i) {
+		auto scalar = nytl::closestPoint(tet, points3[i]);
+		EXPECT(nytl::distanceSq(tet, points3[i]),
+			nytl::approx(nytl::dot(out3[i] - points3[i], out3[i] - points3[i]), 0.00001));
+		EXPECT(out3[i], nytl::approx(scalar, 0.00001));
+	}
+}
@@ -0,0 +1,48 @@
+#include "test.hpp"
+#include <nytl/staticCallback.hpp>
+
+TEST(basic) {
+	auto a = 0, b = 0;
+	nytl::StaticCallback cb {
+		[&](int v) { a += v; },
+		[&](int v) { b += 2 * v; }
+	};
+
+	static_assert(cb.listenerCount == 2);
+	cb(3);
+	EXPECT(a, 3);
+	EXPECT(b, 6);
+
+	// disabled listeners are skipped
+	cb.disable<1>();
+	cb.call(1);
+	EXPECT(a, 4);
+	EXPECT(b, 6);
+
+	cb.enable<1>();
+	cb(1);
+	EXPECT(b, 8);
+}
+
+TEST(connection) {
+	auto count = 0;
+	nytl::StaticCallback cb {
+		[&] { ++count; },
+		[&] { count += 10; }
+	};
+
+	auto conn = cb.connection<0>();
+	EXPECT(conn.connected(), true);
+
+	cb();
+	EXPECT(count, 11);
+
+	conn.disconnect();
+	EXPECT(conn.connected(), false);
+	cb();
+	EXPECT(count, 21);
+
+	// direct listener access
+	cb.listener<1>()();
+	EXPECT(count, 31);
+}
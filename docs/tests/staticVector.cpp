@@ -0,0 +1,68 @@
+#include "test.hpp"
+#include <nytl/staticVector.hpp>
+#include <nytl/span.hpp>
+#include <string>
+
+TEST(basic) {
+	nytl::StaticVector<int, 4> vec;
+	EXPECT(vec.empty(), true);
+	EXPECT(vec.capacity(), 4u);
+
+	vec.push_back(1);
+	vec.push_back(2);
+	vec.emplace_back(3);
+	EXPECT(vec.size(), 3u);
+	EXPECT(vec[0], 1);
+	EXPECT(vec.back(), 3);
+
+	// span conversion and range-based for
+	auto span = nytl::span<const int>(vec);
+	EXPECT(span.size(), 3u);
+	auto sum = 0;
+	for(auto v : vec) {
+		sum += v;
+	}
+	EXPECT(sum, 6);
+
+	vec.pop_back();
+	EXPECT(vec.size(), 2u);
+
+	auto copy = vec;
+	EXPECT(copy == vec, true);
+	copy.push_back(7);
+	EXPECT(copy != vec, true);
+
+	vec.clear();
+	EXPECT(vec.empty(), true);
+}
+
+TEST(nonTrivial) {
+	// non-trivially-destructible elements are destroyed properly
+	auto alive = 0;
+	struct Probe {
+		int* count;
+		Probe(int* c) : count(c) { ++*count; }
+		Probe(const Probe& rhs) : count(rhs.count) { ++*count; }
+		Probe(Probe&& rhs) noexcept : count(rhs.count) { ++*count; }
+		~Probe() { --*count; }
+	};
+
+	{
+		nytl::StaticVector<Probe, 8> vec;
+		vec.emplace_back(&alive);
+		vec.emplace_back(&alive);
+		EXPECT(alive, 2);
+
+		auto moved = std::move(vec);
+		EXPECT(vec.empty(), true);
+		EXPECT(alive, 2);
+
+		moved.pop_back();
+		EXPECT(alive, 1);
+	}
+
+	EXPECT(alive, 0);
+
+	nytl::StaticVector<std::string, 2> strs(2, "hello");
+	EXPECT(strs[1], std::string("hello"));
+}
@@ -0,0 +1,112 @@
+#include "test.hpp"
+#include <nytl/stridedSpan.hpp>
+#include <nytl/approx.hpp>
+#include <nytl/vec3.hpp>
+#include <nytl/vec2.hpp>
+#include <vector>
+
+namespace {
+
+struct Vertex {
+	nytl::Vec3f position;
+	nytl::Vec3f normal;
+	nytl::Vec2f uv;
+};
+
+} // anon namespace
+
+TEST(strided) {
+	std::vector<Vertex> vertices(4);
+	for(auto i = 0u; i < vertices.size(); ++i) {
+		vertices[i].position = {float(i), 0.f, 0.f};
+		vertices[i].uv = {0.f, float(i)};
+	}
+
+	auto positions = nytl::StridedSpan<nytl::Vec3f>(
+		&vertices[0].position, vertices.size(), sizeof(Vertex));
+	EXPECT(positions.size(), 4u);
+	EXPECT(positions.contiguous(), false);
+	EXPECT(positions[2].x, 2.f);
+
+	positions[2].x = 7.f;
+	EXPECT(vertices[2].position.x, 7.f);
+
+	auto sub = positions.subspan(1, 2);
+	EXPECT(sub.size(), 2u);
+	EXPECT(sub[1].x, 7.f);
+
+	// iteration follows the stride
+	auto sum = 0.f;
+	for(auto& pos : positions) {
+		sum += pos.x;
+	}
+	EXPECT(sum, 11.f);
+
+	// compile-time stride
+	auto uvs = nytl::StridedSpan<nytl::Vec2f, sizeof(Vertex)>(
+		reinterpret_cast<std::byte*>(&vertices[0].uv),
+		vertices.size(), sizeof(Vertex));
+	EXPECT(uvs[3].y, 3.f);
+}
+
+TEST(batchInterop) {
+	std::vector<Vertex> vertices(3);
+	vertices[0].position = {3.f, 0.f, 4.f};
+	vertices[1].position = {0.f, 0.f, 2.f};
+	vertices[2].position = {1.f, 0.f, 0.f};
+
+	auto positions = nytl::StridedSpan<const nytl::Vec3f>(
+		&vertices[0].position, vertices.size(), sizeof(Vertex));
+
+	nytl::VecSoA<3, float> soa;
+	nytl::gather(positions, soa);
+	EXPECT(soa.size(), 3u);
+
+	std::vector<float> lengths(3);
+	nytl::length(soa, nytl::span<float>(lengths));
+	EXPECT(lengths[0], nytl::approx(5.f));
+	EXPECT(lengths[1], nytl::approx(2.f));
+	EXPECT(lengths[2], nytl::approx(1.f));
+}
+
+TEST(bytesInterop) {
+	std::vector<Vertex> vertices(3);
+	for(auto i = 0u; i < vertices.size(); ++i) {
+		vertices[i].position = {float(i), float(2 * i), 0.f};
+	}
+
+	auto positions = nytl::StridedSpan<const nytl::Vec3f>(
+		&vertices[0].position, vertices.size(), sizeof(Vertex));
+
+	// written packed, without the interleaving padding
+	std::vector<std::byte> data(3 * sizeof(nytl::Vec3f));
+	auto buf = nytl::WriteBuf(data);
+	nytl::write(buf, positions);
+	EXPECT(buf.empty(), true);
+
+	std::vector<Vertex> restored(3);
+	auto dst = nytl::StridedSpan<nytl::Vec3f>(
+		&restored[0].position, restored.size(), sizeof(Vertex));
+	auto src = nytl::ReadBuf(data);
+	nytl::read(src, dst);
+	EXPECT(restored[2].position.y, 4.f);
+}
+
+TEST(span2d) {
+	// 4x3 image with 2 floats of row padding
+	std::vector<float> pixels(6 * 3, 0.f);
+	auto image = nytl::Span2D<float>(pixels.data(), 4, 3,
+		6 * sizeof(float));
+
+	image(3, 2) = 9.f;
+	EXPECT(pixels[2 * 6 + 3], 9.f);
+	EXPECT(image.row(2)[3], 9.f);
+	EXPECT(image.column(3)[2], 9.f);
+
+	auto sub = image.sub(2, 1, 2, 2);
+	EXPECT(sub.width(), 2u);
+	EXPECT(sub(1, 1), 9.f);
+
+	sub(0, 0) = 5.f;
+	EXPECT(image(2, 1), 5.f);
+}
@@ -0,0 +1,32 @@
+#include "test.hpp"
+#include <nytl/stringParam.hpp>
+#include <string>
+#include <unordered_map>
+
+TEST(hashed) {
+	constexpr auto color = nytl::HashedStringParam("u_color");
+	static_assert(color.hash() == nytl::fnv1a<char>("u_color"));
+	static_assert(color.size() == 7);
+
+	// known FNV-1a reference values
+	static_assert(nytl::fnv1a<char>("") == 0xcbf29ce484222325u);
+	static_assert(nytl::fnv1a<char>("a") == 0xaf63dc4c8601ec8cu);
+
+	auto runtime = nytl::HashedStringParam(std::string("u_color"));
+	EXPECT(runtime == color, true);
+	EXPECT(runtime.hash(), color.hash());
+	EXPECT(runtime != nytl::HashedStringParam("u_normal"), true);
+
+	// still usable everywhere a StringParam/string_view is expected
+	EXPECT(std::string_view(color), std::string_view("u_color"));
+	EXPECT(color.c_str()[7], '\0');
+}
+
+TEST(lookup) {
+	std::unordered_map<nytl::HashedStringParam, int> bindings;
+	bindings[nytl::HashedStringParam("u_color")] = 1;
+	bindings[nytl::HashedStringParam("u_normal")] = 2;
+
+	EXPECT(bindings.at("u_normal"), 2);
+	EXPECT(bindings.count("u_missing"), std::size_t(0));
+}
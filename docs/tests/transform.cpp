@@ -0,0 +1,129 @@
+#include "test.hpp"
+#include <nytl/transform.hpp>
+#include <nytl/transformTree.hpp>
+#include <nytl/approxVec.hpp>
+
+TEST(transform3) {
+	nytl::Transform3 t;
+	EXPECT(t.dirty(), false);
+	EXPECT(t.matrix(), nytl::approx(nytl::identity<4, float>()));
+
+	t.translation({1.f, 2.f, 3.f});
+	t.scaling({2.f, 2.f, 2.f});
+	t.rotation(nytl::Quaternion::axisAngle(0, 1, 0, 0.5));
+
+	// matches the explicit matrix composition
+	auto expected = nytl::translateMat<4, float>(nytl::Vec3f {1.f, 2.f, 3.f}) *
+		nytl::toMat<4, float>(nytl::Quaternion::axisAngle(0, 1, 0, 0.5)) *
+		nytl::scaleMat<4, float>(nytl::Vec3f {2.f, 2.f, 2.f});
+	EXPECT(t.matrix(), nytl::approx(expected, 0.0001));
+	EXPECT(t.dirty(), false);
+
+	// translation patches the cached matrix without dirtying it
+	t.translate({1.f, 0.f, -1.f});
+	EXPECT(t.dirty(), false);
+	EXPECT(t.translation(), nytl::approx(nytl::Vec3f {2.f, 2.f, 2.f}));
+	auto expected2 = nytl::translateMat<4, float>(nytl::Vec3f {1.f, 0.f, -1.f}) * expected;
+	EXPECT(t.matrix(), nytl::approx(expected2, 0.0001));
+
+	// incremental rotate/scale recompose lazily
+	t.rotate(nytl::Quaternion::axisAngle(1, 0, 0, 0.25));
+	EXPECT(t.dirty(), true);
+	auto expected3 = nytl::translateMat<4, float>(t.translation()) *
+		nytl::toMat<4, float>(t.rotation()) *
+		nytl::scaleMat<4, float>(t.scaling());
+	EXPECT(t.matrix(), nytl::approx(expected3, 0.0001));
+	EXPECT(t.dirty(), false);
+}
+
+TEST(transform2) {
+	nytl::Transform2 t;
+	t.rotation(0.5f);
+	t.scaling({3.f, 1.f});
+	t.translate({1.f, 1.f});
+
+	auto expected = nytl::translateMat<3, float>(nytl::Vec2f {1.f, 1.f}) *
+		nytl::rotateMat<3, float>(0.5f) *
+		nytl::scaleMat<3, float>(nytl::Vec2f {3.f, 1.f});
+	EXPECT(t.matrix(), nytl::approx(expected, 0.0001));
+
+	// transforms a point like the composed matrix does
+	auto p = t.matrix() * nytl::Vec3f {1.f, 2.f, 1.f};
+	auto q = expected * nytl::Vec3f {1.f, 2.f, 1.f};
+	EXPECT(p, nytl::approx(q, 0.0001));
+}
+
+TEST(tree) {
+	nytl::TransformTree<float> tree;
+	auto root = tree.add();
+	auto childA = tree.add(root, nytl::translateMat<4, float>(nytl::Vec3f {1.f, 0.f, 0.f}));
+	auto childB = tree.add(root, nytl::translateMat<4, float>(nytl::Vec3f {0.f, 1.f, 0.f}));
+	auto grandchild = tree.add(childA, nytl::scaleMat<4, float>(nytl::Vec3f {2.f, 2.f, 2.f}));
+
+	// first sweep composes everything
+	EXPECT(tree.update(), 4u);
+	EXPECT(tree.world(root), nytl::approx(nytl::identity<4, float>()));
+	EXPECT(tree.world(childA), nytl::approx(tree.local(childA)));
+	EXPECT(tree.world(grandchild),
+		nytl::approx(tree.local(childA) * tree.local(grandchild)));
+
+	// clean tree: nothing recomposed
+	EXPECT(tree.update(), 0u);
+
+	// dirtying a node updates exactly its subtree
+	tree.local(childA, nytl::translateMat<4, float>(nytl::Vec3f {5.f, 0.f, 0.f}));
+	EXPECT(tree.update(), 2u);
+	EXPECT(tree.world(grandchild),
+		nytl::approx(tree.local(childA) * tree.local(grandchild)));
+	EXPECT(tree.world(childB), nytl::approx(tree.local(childB)));
+
+	// root change propagates to all nodes
+	tree.local(root, nytl::translateMat<4, float>(nytl::Vec3f {0.f, 0.f, 3.f}));
+	EXPECT(tree.update(), 4u);
+	EXPECT(tree.world(childB),
+		nytl::approx(tree.local(root) * tree.local(childB)));
+
+	// contiguous upload view
+	EXPECT(tree.worldMatrices().size(), 4u);
+	EXPECT(tree.worldBytes().size(), 4 * sizeof(nytl::Mat4f));
+}
+
+TEST(batch) {
+	std::vector<nytl::Vec3f> points(64);
+	for(auto i = 0u; i < points.size(); ++i) {
+		points[i] = {float(i), 1.f, -float(i)};
+	}
+
+	// affine: matches multPos, no divide involved
+	auto affine = nytl::translateMat<4, float>(nytl::Vec3f {1.f, 2.f, 3.f}) *
+		nytl::scaleMat<4, float>(nytl::Vec3f {2.f, 2.f, 2.f});
+	std::vector<nytl::Vec3f> out(points.size());
+	nytl::transformPoints(affine,
+		nytl::span<const nytl::Vec3f>(points), nytl::span<nytl::Vec3f>(out));
+	for(auto i = 0u; i < points.size(); ++i) {
+		EXPECT(out[i], nytl::approx(nytl::multPos(affine, points[i])));
+	}
+
+	// projective: w divide matches multPos
+	auto proj = nytl::perspective<float>(nytl::radians(60.f), 1.5f, 0.1f, 100.f);
+	std::vector<nytl::Vec3f> front(16);
+	for(auto i = 0u; i < front.size(); ++i) {
+		front[i] = {0.25f * i, -0.5f * i, -1.f - float(i)};
+	}
+
+	std::vector<nytl::Vec3f> projected(front.size());
+	nytl::transformPoints(proj,
+		nytl::span<const nytl::Vec3f>(front),
+		nytl::span<nytl::Vec3f>(projected));
+	for(auto i = 0u; i < front.size(); ++i) {
+		EXPECT(projected[i],
+			nytl::approx(nytl::multPos(proj, front[i]), 0.0001));
+	}
+
+	// directions ignore the translation, in-place transform works
+	std::vector<nytl::Vec3f> dirs {{1.f, 0.f, 0.f}, {0.f, 0.f, 1.f}};
+	nytl::transformDirections(affine,
+		nytl::span<const nytl::Vec3f>(dirs), nytl::span<nytl::Vec3f>(dirs));
+	EXPECT(dirs[0], nytl::approx(nytl::Vec3f {2.f, 0.f, 0.f}));
+	EXPECT(dirs[1], nytl::approx(nytl::Vec3f {0.f, 0.f, 2.f}));
+}
@@ -45,3 +45,140 @@ TEST(nth) {
 	ERROR(nytl::nth(utf8a, 10, size), std::out_of_range);
 	EXPECT(std::string(nytl::nth(utf8a, 0).data()), std::string(u8"ä"));
 }
+
+TEST(charCount) {
+	// mixed-width string, long enough to exercise the chunked path
+	std::string str;
+	for(auto i = 0u; i < 100; ++i) {
+		str += "a";
+		str += u8"ü";
+		str += u8"€";
+		str += u8"😀";
+	}
+
+	EXPECT(nytl::charCount(str), 400u);
+	EXPECT(nytl::charCount(""), 0u);
+	EXPECT(nytl::charCount("hello world, ascii only string!!"), 32u);
+}
+
+TEST(validate) {
+	EXPECT(nytl::validUtf8(""), true);
+	EXPECT(nytl::validUtf8("plain old ascii, longer than one chunk"), true);
+	EXPECT(nytl::validUtf8(u8"äöü€😀"), true);
+
+	EXPECT(nytl::validUtf8("\x80"), false); // lone continuation
+	EXPECT(nytl::validUtf8("\xc3"), false); // truncated sequence
+	EXPECT(nytl::validUtf8("\xc3\x28"), false); // invalid continuation
+	EXPECT(nytl::validUtf8("\xc0\xaf"), false); // overlong encoding
+	EXPECT(nytl::validUtf8("\xed\xa0\x80"), false); // surrogate
+	EXPECT(nytl::validUtf8("\xf4\x90\x80\x80"), false); // > U+10FFFF
+	EXPECT(nytl::validUtf8("\xff"), false); // invalid lead
+}
+
+TEST(offsets) {
+	auto str = std::string(u8"aäb€c");
+	auto offsets = nytl::charOffsets(str);
+	EXPECT(offsets.size(), nytl::charCount(str));
+	EXPECT(offsets[0], 0u);
+	EXPECT(offsets[1], 1u);
+	EXPECT(offsets[2], 3u);
+	EXPECT(offsets[3], 4u);
+	EXPECT(offsets[4], 7u);
+
+	// offsets match the nth() scan
+	for(auto i = 0u; i < offsets.size(); ++i) {
+		std::uint8_t size;
+		auto& chr = nytl::nth(std::string_view(str), i, size);
+		EXPECT(&chr - str.data(), std::ptrdiff_t(offsets[i]));
+	}
+}
+
+TEST(transcode) {
+	// round trips through all encodings, including surrogate pairs
+	auto utf8 = std::string(u8"hello äöü €, 😀🍌 world");
+	auto utf16 = std::u16string(u"hello äöü €, 😀🍌 world");
+	auto utf32 = std::u32string(U"hello äöü €, 😀🍌 world");
+
+	EXPECT(nytl::toUtf16(utf8) == utf16, true);
+	EXPECT(nytl::toUtf32(utf8) == utf32, true);
+	EXPECT(nytl::toUtf8(utf16) == utf8, true);
+	EXPECT(nytl::toUtf32(utf16) == utf32, true);
+	EXPECT(nytl::toUtf8(utf32) == utf8, true);
+	EXPECT(nytl::toUtf16(utf32) == utf16, true);
+
+	EXPECT(nytl::toUtf8(std::u16string_view{}).empty(), true);
+	EXPECT(nytl::toUtf32(std::string_view{}).empty(), true);
+}
+
+TEST(transcodeBuf) {
+	auto utf32 = std::u32string(U"aä€😀");
+
+	// exact fit
+	std::array<char, 10> utf8buf {};
+	auto count = nytl::toUtf8(utf32, utf8buf);
+	EXPECT(count, 10u);
+	EXPECT(std::string_view(utf8buf.data(), count) == u8"aä€😀", true);
+
+	// too small: stops before the char that would not fit completely
+	std::array<char, 8> small {};
+	EXPECT(nytl::toUtf8(utf32, small), 6u);
+
+	std::array<char16_t, 8> utf16buf {};
+	count = nytl::toUtf16(utf32, utf16buf);
+	EXPECT(count, 5u);
+	EXPECT(std::u16string_view(utf16buf.data(), count) == u"aä€😀", true);
+
+	std::array<char32_t, 8> utf32buf {};
+	count = nytl::toUtf32(std::u16string_view(u"aä€😀"), utf32buf);
+	EXPECT(count, 4u);
+	EXPECT(std::u32string_view(utf32buf.data(), count) == utf32, true);
+}
+
+TEST(cursor) {
+	auto str = std::string(u8"aä€😀b");
+	nytl::Utf8Cursor cursor(str);
+
+	EXPECT(cursor.charPosition(), 0u);
+	EXPECT(std::strcmp(cursor.current().data(), u8"a"), 0);
+
+	EXPECT(cursor.next(), true);
+	EXPECT(std::strcmp(cursor.current().data(), u8"ä"), 0);
+	EXPECT(cursor.byteOffset(), 1u);
+
+	cursor.seek(3);
+	EXPECT(std::strcmp(cursor.current().data(), u8"😀"), 0);
+
+	cursor.seek(1);
+	EXPECT(std::strcmp(cursor.current().data(), u8"ä"), 0);
+
+	EXPECT(cursor.prev(), true);
+	EXPECT(cursor.prev(), false);
+	EXPECT(cursor.charPosition(), 0u);
+
+	cursor.seek(5);
+	EXPECT(cursor.atEnd(), true);
+	EXPECT(cursor.next(), false);
+}
+
+TEST(index) {
+	// small stride to exercise both the jump and the scan part
+	std::string str;
+	for(auto i = 0u; i < 50; ++i) {
+		str += u8"aä€😀";
+	}
+
+	nytl::Utf8Index index(str, 4);
+	EXPECT(index.charCount(), 200u);
+	EXPECT(index.byteOffset(200), str.size());
+
+	for(auto i = 0u; i < index.charCount(); ++i) {
+		std::uint8_t size;
+		auto& chr = nytl::nth(std::string_view(str), i, size);
+		EXPECT(&chr - str.data(), std::ptrdiff_t(index.byteOffset(i)));
+	}
+
+	EXPECT(std::strcmp(index.nth(0).data(), u8"a"), 0);
+	EXPECT(std::strcmp(index.nth(7).data(), u8"😀"), 0);
+	ERROR(index.nth(200), std::out_of_range);
+	ERROR(index.byteOffset(201), std::out_of_range);
+}
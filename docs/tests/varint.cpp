@@ -0,0 +1,76 @@
+#include "test.hpp"
+#include <nytl/varint.hpp>
+#include <vector>
+
+TEST(varint) {
+	nytl::DynWriteBuf buf;
+	nytl::writeVarint(buf, std::uint64_t {0});
+	nytl::writeVarint(buf, std::uint64_t {127});
+	nytl::writeVarint(buf, std::uint64_t {128});
+	nytl::writeVarint(buf, std::uint64_t {300});
+	nytl::writeVarint(buf, ~std::uint64_t {0});
+
+	// 1 + 1 + 2 + 2 + 10
+	EXPECT(buf.size(), 16u);
+	EXPECT(buf[0], std::byte {0x00});
+	EXPECT(buf[2], std::byte {0x80}); // 128: low byte with continuation
+	EXPECT(buf[3], std::byte {0x01});
+
+	nytl::ReadBuf src = buf;
+	EXPECT(nytl::readVarint(src), 0u);
+	EXPECT(nytl::readVarint(src), 127u);
+	EXPECT(nytl::readVarint(src), 128u);
+	EXPECT(nytl::readVarint(src), 300u);
+	EXPECT(nytl::readVarint(src), ~std::uint64_t {0});
+	EXPECT(src.empty(), true);
+}
+
+TEST(zigzag) {
+	EXPECT(nytl::mapUnsigned(std::int64_t {0}), 0u);
+	EXPECT(nytl::mapUnsigned(std::int64_t {-1}), 1u);
+	EXPECT(nytl::mapUnsigned(std::int64_t {1}), 2u);
+	EXPECT(nytl::unmapUnsigned(std::uint64_t {3}), -2);
+	for(auto v : {std::int64_t {0}, std::int64_t {-1000}, std::int64_t {1} << 62,
+			-(std::int64_t {1} << 62)}) {
+		EXPECT(nytl::unmapUnsigned(nytl::mapUnsigned(v)), v);
+	}
+
+	nytl::DynWriteBuf buf;
+	nytl::writeSignedVarint(buf, -2);
+	EXPECT(buf.size(), 1u);
+
+	nytl::ReadBuf src = buf;
+	EXPECT(nytl::readSignedVarint(src), -2);
+}
+
+TEST(delta) {
+	// monotonically increasing timestamps with small steps
+	std::vector<std::uint64_t> stamps(1000);
+	auto t = std::uint64_t {1'000'000'000};
+	for(auto& s : stamps) {
+		s = t;
+		t += 16 + (t % 7);
+	}
+
+	nytl::DynWriteBuf buf;
+	nytl::writeDelta(buf, nytl::span<const std::uint64_t>(stamps));
+
+	// roughly one byte per value instead of eight
+	EXPECT(buf.size() < stamps.size() * 2 + nytl::maxVarintSize, true);
+
+	std::vector<std::uint64_t> decoded(stamps.size());
+	nytl::ReadBuf src = buf;
+	EXPECT(nytl::readDelta(src, nytl::span<std::uint64_t>(decoded)), stamps.size());
+	EXPECT(src.empty(), true);
+	EXPECT(decoded == stamps, true);
+
+	// non-monotonic signed sequences roundtrip as well
+	std::vector<std::int64_t> vals {5, -3, 1000, -1000, 0, 17};
+	buf.clear();
+	nytl::writeDelta(buf, nytl::span<const std::int64_t>(vals));
+
+	std::vector<std::int64_t> decoded2(vals.size());
+	src = buf;
+	EXPECT(nytl::readDelta(src, nytl::span<std::int64_t>(decoded2)), vals.size());
+	EXPECT(decoded2 == vals, true);
+}
@@ -10,6 +10,7 @@
 #include <nytl/vec.hpp>
 #include <nytl/vecOps.hpp>
 #include <nytl/math.hpp>
+#include <nytl/vecExpr.hpp>
 
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wunused-const-variable"
@@ -83,6 +84,29 @@ TEST(deduction) {
 	static_assert(std::is_same_v<decltype(c), nytl::Vec2ui>);
 }
 
+TEST(vec4_members) {
+	auto v = Vec4d {1.0, 2.0, 3.0, 4.0};
+	EXPECT(v.x, 1.0);
+	EXPECT(v.y, 2.0);
+	EXPECT(v.z, 3.0);
+	EXPECT(v.w, 4.0);
+
+	v[3] = 5.0;
+	EXPECT(v.w, 5.0);
+	EXPECT(&v[0], v.data());
+	EXPECT(v.end() - v.begin(), 4);
+
+	ERROR(v[4], std::out_of_range);
+	static_assert(sizeof(Vec4f) == 4 * sizeof(float));
+
+#ifdef NYTL_VEC_ALIGN_SIMD
+	static_assert(alignof(Vec4f) == 16);
+	static_assert(alignof(Vec2d) == 16);
+	static_assert(alignof(Vec4d) == 32);
+	static_assert(sizeof(Vec3f) == 3 * sizeof(float));
+#endif
+}
+
 TEST(basic) {
 	auto cpy = d3a;
 	cpy += d3c;
@@ -229,6 +253,31 @@ TEST(cross_product) {
 	// nytl::cross(Vec4d{1.0, 2.0, 3.0, 4.0}, d3b);
 }
 
+TEST(expr) {
+	auto a = Vec3d {1.0, 2.0, 3.0};
+	auto b = Vec3d {0.0, -1.0, 2.0};
+	auto c = Vec3d {2.0, 2.0, 2.0};
+
+	// fused evaluation must match the eager operators
+	auto r1 = vex::eval(0.5 * (vex::expr(a) + b) - c);
+	EXPECT(r1, nytl::approx(0.5 * (a + b) - c));
+
+	auto r2 = vex::eval(-(vex::expr(a) - b) + 2 * vex::expr(c));
+	EXPECT(r2, nytl::approx(-(a - b) + 2 * c));
+
+	auto r3 = vex::eval(vex::expr(a) / 2.0);
+	EXPECT(r3, nytl::approx(Vec3d {0.5, 1.0, 1.5}));
+
+	Vec3d out {};
+	vex::assign(out, vex::expr(a) + b);
+	EXPECT(out, nytl::approx(a + b));
+
+	// expressions can be evaluated at compile time
+	constexpr auto ce = vex::eval(2.0 * (vex::expr(d3a) + d3c));
+	static_assert(ce.size() == 3);
+	EXPECT(ce, nytl::approx(2.0 * (d3a + d3c)));
+}
+
 TEST(component_wise) {
 	using namespace nytl::vec::cw;
 
@@ -249,3 +298,16 @@ TEST(component_wise) {
 	// pow
 	EXPECT(pow(d3f, 1), d3f);
 }
+
+TEST(format) {
+	char buf[64];
+	auto len = nytl::format(buf, nytl::Vec3i {1, -2, 30});
+	EXPECT(std::string(buf, len), std::string("(1, -2, 30)"));
+
+	len = nytl::format(buf, nytl::Vec2f {0.5f, -1.25f});
+	EXPECT(std::string(buf, len), std::string("(0.5, -1.25)"));
+
+	// too small buffers write nothing
+	EXPECT(nytl::format(nytl::span<char>(buf, 4), nytl::Vec3i {1, -2, 30}), 0u);
+	EXPECT(nytl::format(nytl::span<char>(buf, std::size_t(0)), nytl::Vec3i {1, -2, 30}), 0u);
+}
@@ -0,0 +1,75 @@
+#include "test.hpp"
+#include <nytl/approx.hpp>
+#include <nytl/approxVec.hpp>
+#include <nytl/vecBatchOps.hpp>
+#include <nytl/vecOps.hpp>
+
+#include <cmath>
+
+using namespace nytl;
+
+TEST(soa_basic) {
+	VecSoA<3, float> soa;
+	EXPECT(soa.empty(), true);
+
+	soa.push_back({1.f, 2.f, 3.f});
+	soa.push_back({-1.f, 0.f, 5.f});
+	EXPECT(soa.size(), 2u);
+	EXPECT(soa[0], (Vec3f {1.f, 2.f, 3.f}));
+	EXPECT(soa[1], (Vec3f {-1.f, 0.f, 5.f}));
+
+	soa.set(1, {0.f, 1.f, 0.f});
+	EXPECT(soa[1], (Vec3f {0.f, 1.f, 0.f}));
+	EXPECT(soa.component(2).size(), 2u);
+	EXPECT(soa.component(2)[0], 3.f);
+
+	soa.clear();
+	EXPECT(soa.empty(), true);
+}
+
+TEST(soa_kernels) {
+	VecSoA<3, double> a, b;
+	std::vector<Vec3d> va, vb;
+	for(auto i = 0u; i < 37u; ++i) {
+		auto v1 = Vec3d {1.0 + i, -0.5 * i, 3.0};
+		auto v2 = Vec3d {0.25 * i, 2.0, -1.0 - i};
+		a.push_back(v1);
+		b.push_back(v2);
+		va.push_back(v1);
+		vb.push_back(v2);
+	}
+
+	std::vector<double> out(a.size());
+	dot(a, b, span<double>(out));
+	for(auto i = 0u; i < out.size(); ++i)
+		EXPECT(out[i], approx(dot(va[i], vb[i])));
+
+	length(a, span<double>(out));
+	for(auto i = 0u; i < out.size(); ++i)
+		EXPECT(out[i], approx(length(va[i])));
+
+	distance(a, b, span<double>(out));
+	for(auto i = 0u; i < out.size(); ++i)
+		EXPECT(out[i], approx(distance(va[i], vb[i])));
+
+	normalize(a);
+	for(auto i = 0u; i < a.size(); ++i) {
+		EXPECT(length(a[i]), approx(1.0));
+		EXPECT(a[i], approx(normalized(va[i])));
+	}
+}
+
+TEST(aos_kernels) {
+	std::vector<Vec2d> va {{1.0, 2.0}, {3.0, -4.0}, {0.5, 0.0}};
+	std::vector<Vec2d> vb {{0.0, 1.0}, {-1.0, 1.0}, {2.0, 2.0}};
+
+	std::vector<double> out(va.size());
+	dot(span<const Vec2d>(va), span<const Vec2d>(vb), span<double>(out));
+	EXPECT(out[0], approx(2.0));
+	EXPECT(out[1], approx(-7.0));
+	EXPECT(out[2], approx(1.0));
+
+	normalize(span<Vec2d>(va));
+	for(auto& v : va)
+		EXPECT(length(v), approx(1.0));
+}
@@ -0,0 +1,341 @@
+// Copyright (c) 2017-2020 nyorain
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt
+
+/// \file Defines the AtlasAllocator class, a 2D rect packing allocator.
+
+#pragma once
+
+#ifndef NYTL_INCLUDE_ATLAS_ALLOCATOR
+#define NYTL_INCLUDE_ATLAS_ALLOCATOR
+
+#include <nytl/rect.hpp> // nytl::Rect
+#include <nytl/vec.hpp> // nytl::Vec
+#include <nytl/vec2.hpp> // nytl::Vec2
+
+#include <vector> // std::vector
+#include <array> // std::array
+#include <utility> // std::move
+#include <cstdint> // std::uint32_t
+#include <cassert> // assert
+
+namespace nytl {
+
+/// \brief Allocates sub-rectangles from a fixed 2D extent, e.g. glyph
+/// or icon slots from a texture atlas.
+/// Two strategies:
+/// - shelf: rows of similar-height allocations, packed left to right.
+///   Cheapest allocation, good for glyph caches where heights cluster;
+///   freed slots are recycled within their shelf.
+/// - guillotine: maintains a free list of disjoint rects, splits the
+///   chosen rect on allocation and merges perfectly adjacent free
+///   rects again on free, which keeps fragmentation low under mixed
+///   sizes.
+/// For the guillotine strategy the free rects are additionally indexed
+/// into size buckets by the log2 of their smaller side, so allocation
+/// only scans slots that can possibly fit instead of the whole free
+/// list. occupancy() reports the allocated fraction of the atlas.
+template<typename T = unsigned int>
+class AtlasAllocator {
+public:
+	using Rect = Rect2<T>;
+	using Vec = Vec2<T>;
+
+	enum class Strategy {
+		shelf,
+		guillotine,
+	};
+
+public:
+	AtlasAllocator() = default;
+	AtlasAllocator(Vec extent, Strategy strategy = Strategy::guillotine)
+			: extent_(extent), strategy_(strategy) {
+		clear();
+	}
+
+	/// Allocates a rect of the given size.
+	/// Returns an empty rect (size {0, 0}) when the request cannot be
+	/// satisfied; requests with a zero component always fail.
+	Rect alloc(Vec size) {
+		if(size.x == T(0) || size.y == T(0)
+				|| size.x > extent_.x || size.y > extent_.y) {
+			return {};
+		}
+
+		auto ret = (strategy_ == Strategy::shelf) ?
+			allocShelf(size) : allocGuillotine(size);
+		if(ret.size.x != T(0)) {
+			used_ += std::uint64_t(ret.size.x) * ret.size.y;
+		}
+
+		return ret;
+	}
+
+	/// Frees a rect previously returned by alloc.
+	/// Passing a rect that was not allocated (or freeing twice) is
+	/// undefined behavior.
+	void free(const Rect& rect) {
+		assert(used_ >= std::uint64_t(rect.size.x) * rect.size.y);
+		used_ -= std::uint64_t(rect.size.x) * rect.size.y;
+		if(strategy_ == Strategy::shelf) {
+			freeShelf(rect);
+		} else {
+			freeGuillotine(rect);
+		}
+	}
+
+	/// Frees everything, resetting the atlas to one empty extent.
+	void clear() {
+		used_ = 0u;
+		shelves_.clear();
+		shelfY_ = T(0);
+		for(auto& bucket : free_) {
+			bucket.clear();
+		}
+
+		if(strategy_ == Strategy::guillotine
+				&& extent_.x != T(0) && extent_.y != T(0)) {
+			insertFree({{T(0), T(0)}, extent_});
+		}
+	}
+
+	/// The allocated fraction of the atlas area, in [0, 1].
+	[[nodiscard]] double occupancy() const {
+		auto total = double(extent_.x) * double(extent_.y);
+		return total > 0.0 ? double(used_) / total : 0.0;
+	}
+
+	[[nodiscard]] Vec extent() const { return extent_; }
+	[[nodiscard]] Strategy strategy() const { return strategy_; }
+
+protected:
+	// - shelf strategy -
+	struct Shelf {
+		T y; // top of the shelf
+		T height;
+		T x; // packing cursor
+		std::vector<Rect> slots; // freed rects, recycled first
+	};
+
+	Rect allocShelf(Vec size) {
+		// best fit: the lowest shelf that is high enough; also
+		// recycle freed slots of fitting shelves along the way
+		Shelf* best = nullptr;
+		for(auto& shelf : shelves_) {
+			if(shelf.height < size.y) {
+				continue;
+			}
+
+			for(auto it = shelf.slots.begin(); it != shelf.slots.end(); ++it) {
+				if(it->size.x >= size.x) {
+					auto pos = it->position;
+					if(it->size.x == size.x) {
+						shelf.slots.erase(it);
+					} else {
+						it->position.x += size.x;
+						it->size.x -= size.x;
+					}
+
+					return {pos, size};
+				}
+			}
+
+			if(extent_.x - shelf.x >= size.x
+					&& (!best || shelf.height < best->height)) {
+				best = &shelf;
+			}
+		}
+
+		if(best) {
+			auto pos = Vec {best->x, best->y};
+			best->x += size.x;
+			return {pos, size};
+		}
+
+		// open a new shelf below the existing ones
+		if(extent_.y - shelfY_ < size.y) {
+			return {};
+		}
+
+		shelves_.push_back({shelfY_, size.y, size.x, {}});
+		auto pos = Vec {T(0), shelfY_};
+		shelfY_ += size.y;
+		return {pos, size};
+	}
+
+	void freeShelf(const Rect& rect) {
+		for(auto& shelf : shelves_) {
+			if(rect.position.y != shelf.y) {
+				continue;
+			}
+
+			// merge with horizontally touching slots of this shelf
+			auto slot = Rect {rect.position, {rect.size.x, shelf.height}};
+			for(auto it = shelf.slots.begin(); it != shelf.slots.end();) {
+				if(it->position.x + it->size.x == slot.position.x) {
+					slot.position.x = it->position.x;
+					slot.size.x += it->size.x;
+					it = shelf.slots.erase(it);
+				} else if(slot.position.x + slot.size.x == it->position.x) {
+					slot.size.x += it->size.x;
+					it = shelf.slots.erase(it);
+				} else {
+					++it;
+				}
+			}
+
+			// slot at the packing cursor: give it back to the cursor
+			if(slot.position.x + slot.size.x == shelf.x) {
+				shelf.x = slot.position.x;
+			} else {
+				shelf.slots.push_back(slot);
+			}
+
+			return;
+		}
+
+		assert(false && "nytl::AtlasAllocator::free: rect matches no shelf");
+	}
+
+	// - guillotine strategy -
+	static unsigned bucketOf(Vec size) {
+		auto min = size.x < size.y ? size.x : size.y;
+		auto bucket = 0u;
+		while((T(1) << (bucket + 1)) <= min && bucket + 1 < numBuckets) {
+			++bucket;
+		}
+
+		return bucket;
+	}
+
+	void insertFree(Rect rect) {
+		free_[bucketOf(rect.size)].push_back(rect);
+	}
+
+	Rect allocGuillotine(Vec size) {
+		// a fitting slot has min(w, h) >= min of the request, i.e.
+		// lives in this or a higher bucket; within the candidates
+		// pick the one wasting the least area
+		Rect* best = nullptr;
+		auto bestWaste = std::uint64_t(-1);
+		for(auto b = bucketOf(size); b < numBuckets; ++b) {
+			for(auto& slot : free_[b]) {
+				if(slot.size.x < size.x || slot.size.y < size.y) {
+					continue;
+				}
+
+				auto waste = std::uint64_t(slot.size.x) * slot.size.y
+					- std::uint64_t(size.x) * size.y;
+				if(waste < bestWaste) {
+					best = &slot;
+					bestWaste = waste;
+				}
+			}
+
+			if(best) {
+				break;
+			}
+		}
+
+		if(!best) {
+			return {};
+		}
+
+		// split the remainder along the longer leftover axis, which
+		// tends to keep the pieces squarish
+		auto slot = *best;
+		auto& bucket = free_[bucketOf(slot.size)];
+		*best = bucket.back();
+		bucket.pop_back();
+
+		auto ret = Rect {slot.position, size};
+		auto rightW = T(slot.size.x - size.x);
+		auto bottomH = T(slot.size.y - size.y);
+		if(rightW > bottomH) {
+			// full-height right part, bottom part only under the alloc
+			if(rightW != T(0)) {
+				insertFree({{T(slot.position.x + size.x), slot.position.y},
+					{rightW, slot.size.y}});
+			}
+			if(bottomH != T(0)) {
+				insertFree({{slot.position.x, T(slot.position.y + size.y)},
+					{size.x, bottomH}});
+			}
+		} else {
+			if(bottomH != T(0)) {
+				insertFree({{slot.position.x, T(slot.position.y + size.y)},
+					{slot.size.x, bottomH}});
+			}
+			if(rightW != T(0)) {
+				insertFree({{T(slot.position.x + size.x), slot.position.y},
+					{rightW, size.y}});
+			}
+		}
+
+		return ret;
+	}
+
+	void freeGuillotine(Rect rect) {
+		// merge with free rects sharing a full edge, repeatedly until
+		// no neighbor merges anymore
+		auto merged = true;
+		while(merged) {
+			merged = false;
+			for(auto b = 0u; b < numBuckets && !merged; ++b) {
+				auto& bucket = free_[b];
+				for(auto it = bucket.begin(); it != bucket.end(); ++it) {
+					auto m = tryMerge(rect, *it);
+					if(m.size.x != T(0)) {
+						rect = m;
+						*it = bucket.back();
+						bucket.pop_back();
+						merged = true;
+						break;
+					}
+				}
+			}
+		}
+
+		insertFree(rect);
+	}
+
+	// the merged rect if a and b share a full edge, an empty rect otherwise
+	static Rect tryMerge(const Rect& a, const Rect& b) {
+		if(a.position.y == b.position.y && a.size.y == b.size.y) {
+			if(a.position.x + a.size.x == b.position.x) {
+				return {a.position, {T(a.size.x + b.size.x), a.size.y}};
+			} else if(b.position.x + b.size.x == a.position.x) {
+				return {b.position, {T(a.size.x + b.size.x), a.size.y}};
+			}
+		}
+
+		if(a.position.x == b.position.x && a.size.x == b.size.x) {
+			if(a.position.y + a.size.y == b.position.y) {
+				return {a.position, {a.size.x, T(a.size.y + b.size.y)}};
+			} else if(b.position.y + b.size.y == a.position.y) {
+				return {b.position, {a.size.x, T(a.size.y + b.size.y)}};
+			}
+		}
+
+		return {};
+	}
+
+protected:
+	static constexpr auto numBuckets = 24u;
+
+	Vec extent_ {};
+	Strategy strategy_ {Strategy::guillotine};
+	std::uint64_t used_ {};
+
+	// shelf state
+	std::vector<Shelf> shelves_ {};
+	T shelfY_ {};
+
+	// guillotine state: disjoint free rects, bucketed by
+	// log2(min(width, height))
+	std::array<std::vector<Rect>, numBuckets> free_ {};
+};
+
+} // namespace nytl
+
+#endif // header guard
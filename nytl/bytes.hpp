@@ -9,9 +9,13 @@
 
 #include <nytl/span.hpp>
 #include <cstdlib>
+#include <cstdint>
+#include <memory_resource>
 #include <type_traits>
+#include <string_view>
 #include <vector>
 #include <initializer_list>
+#include <limits>
 #include <cassert>
 #include <cstring>
 
@@ -111,6 +115,34 @@ bytes(const std::initializer_list<T>& val) {
 	return nytl::as_bytes(span(val));
 }
 
+// Returns the number of bytes that write(dst, obj) appends for the
+// given object, mirroring the bytes() overload set above. Lets
+// callers sum up a message size and reserve a DynWriteBuf exactly
+// once before serializing.
+template<typename T>
+constexpr std::enable_if_t<BytesConvertible<T>, std::size_t>
+serializedSize(const T&) {
+	return sizeof(T);
+}
+
+template<typename T, std::size_t S>
+constexpr std::enable_if_t<BytesConvertible<T>, std::size_t>
+serializedSize(span<T, S> span) {
+	return span.size() * sizeof(T);
+}
+
+template<typename T>
+constexpr std::enable_if_t<BytesConvertible<T>, std::size_t>
+serializedSize(const std::vector<T>& val) {
+	return val.size() * sizeof(T);
+}
+
+template<typename T>
+constexpr std::enable_if_t<BytesConvertible<T>, std::size_t>
+serializedSize(const std::initializer_list<T>& val) {
+	return val.size() * sizeof(T);
+}
+
 inline void skip(ReadBuf& buf, std::size_t bytes) {
 	NYTL_BYTES_ASSERT(buf.size() >= bytes);
 	buf = buf.last(buf.size() - bytes);
@@ -163,6 +195,29 @@ read(ReadBuf& src, T& obj) {
 	read(src, bytes(obj));
 }
 
+// Returns a view of the next count elements, aliasing the underlying
+// buffer instead of copying, and advances the buffer past them.
+// The view stays valid as long as the memory behind src, not just the
+// buffer itself, so deserialized messages can keep referencing a
+// received buffer without per-field allocation. The current buffer
+// position must be aligned for T; char/byte payloads always are.
+template<typename T>
+std::enable_if_t<BytesConvertible<T>, span<const T>>
+readView(ReadBuf& src, std::size_t count) {
+	NYTL_BYTES_ASSERT(src.size() >= count * sizeof(T));
+	NYTL_BYTES_ASSERT(
+		reinterpret_cast<std::uintptr_t>(src.data()) % alignof(T) == 0);
+	auto ptr = reinterpret_cast<const T*>(src.data());
+	skip(src, count * sizeof(T));
+	return {ptr, count};
+}
+
+// Like readView<char> but returns the view as string_view.
+inline std::string_view readStringView(ReadBuf& src, std::size_t count) {
+	auto view = readView<char>(src, count);
+	return {view.data(), view.size()};
+}
+
 // Does not advance any of the buffers
 inline void copy(ReadBuf src, WriteBuf dst) {
 	NYTL_BYTES_ASSERT(src.size() == dst.size());
@@ -187,6 +242,433 @@ copyExact(ReadBuf src) {
 	return ret;
 }
 
+// Host byte order; assumes little endian when the compiler does not
+// advertise the byte order.
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+	constexpr auto bigEndianHost = true;
+#else
+	constexpr auto bigEndianHost = false;
+#endif
+
+// Returns the given value with reversed byte order.
+// The reversal loop is recognized by optimizing compilers and lowered
+// to a single bswap/byte-shuffle instruction.
+template<typename T>
+T byteswap(T val) {
+	static_assert(BytesConvertible<T> &&
+		(sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8));
+
+	unsigned char tmp[sizeof(T)];
+	std::memcpy(tmp, &val, sizeof(T));
+	for(auto i = 0u; i < sizeof(T) / 2; ++i) {
+		auto o = tmp[i];
+		tmp[i] = tmp[sizeof(T) - 1 - i];
+		tmp[sizeof(T) - 1 - i] = o;
+	}
+
+	std::memcpy(&val, tmp, sizeof(T));
+	return val;
+}
+
+namespace detail {
+
+// Writes the given values with the requested byte order, fusing the
+// swap into the copy: matching-endian hosts take the plain memcpy
+// path, otherwise the payload is swapped in the same single pass
+// that stores it.
+template<bool Swap, typename T>
+void writeEndian(WriteBuf& dst, span<const T> src) {
+	if constexpr(!Swap) {
+		write(dst, ReadBuf(bytes(src)));
+	} else {
+		NYTL_BYTES_ASSERT(dst.size() >= src.size() * sizeof(T));
+		for(auto i = std::size_t {0}; i < src.size(); ++i) {
+			auto swapped = byteswap(src[i]);
+			std::memcpy(dst.data() + i * sizeof(T), &swapped, sizeof(T));
+		}
+
+		skip(dst, src.size() * sizeof(T));
+	}
+}
+
+template<bool Swap, typename T>
+void writeEndian(DynWriteBuf& dst, span<const T> src) {
+	auto off = dst.size();
+	dst.resize(off + src.size() * sizeof(T));
+	auto buf = WriteBuf {dst.data() + off, src.size() * sizeof(T)};
+	writeEndian<Swap>(buf, src);
+}
+
+template<bool Swap, typename T>
+void readEndian(ReadBuf& src, span<T> dst) {
+	NYTL_BYTES_ASSERT(src.size() >= dst.size() * sizeof(T));
+	if constexpr(!Swap) {
+		read(src, WriteBuf(bytes(dst)));
+	} else {
+		for(auto i = std::size_t {0}; i < dst.size(); ++i) {
+			T val;
+			std::memcpy(&val, src.data() + i * sizeof(T), sizeof(T));
+			dst[i] = byteswap(val);
+		}
+
+		skip(src, dst.size() * sizeof(T));
+	}
+}
+
+} // namespace detail
+
+// Little/big endian variants of write() and read() for scalars and
+// spans of scalars. On hosts matching the requested byte order these
+// compile down to the plain memcpy-based functions above.
+template<typename T, typename B>
+std::enable_if_t<BytesConvertible<T>>
+writeLE(B& dst, span<const T> src) {
+	detail::writeEndian<bigEndianHost>(dst, src);
+}
+
+template<typename T, typename B>
+std::enable_if_t<BytesConvertible<T>>
+writeBE(B& dst, span<const T> src) {
+	detail::writeEndian<!bigEndianHost>(dst, src);
+}
+
+template<typename T, typename B>
+std::enable_if_t<BytesConvertible<T>>
+writeLE(B& dst, const T& val) {
+	writeLE(dst, span<const T>(&val, 1));
+}
+
+template<typename T, typename B>
+std::enable_if_t<BytesConvertible<T>>
+writeBE(B& dst, const T& val) {
+	writeBE(dst, span<const T>(&val, 1));
+}
+
+template<typename T>
+std::enable_if_t<BytesConvertible<T>>
+readLE(ReadBuf& src, span<T> dst) {
+	detail::readEndian<bigEndianHost>(src, dst);
+}
+
+template<typename T>
+std::enable_if_t<BytesConvertible<T>>
+readBE(ReadBuf& src, span<T> dst) {
+	detail::readEndian<!bigEndianHost>(src, dst);
+}
+
+template<typename T>
+std::enable_if_t<BytesConvertible<T>, T>
+readLE(ReadBuf& src) {
+	T ret;
+	readLE(src, span<T>(&ret, 1));
+	return ret;
+}
+
+template<typename T>
+std::enable_if_t<BytesConvertible<T>, T>
+readBE(ReadBuf& src) {
+	T ret;
+	readBE(src, span<T>(&ret, 1));
+	return ret;
+}
+
+namespace detail {
+
+// 32-bit fnv-1a, the frame checksum function.
+inline std::uint32_t fnv1a32(ReadBuf data) {
+	auto hash = std::uint32_t {2166136261u};
+	for(auto byte : data) {
+		hash ^= std::uint32_t(byte);
+		hash *= 16777619u;
+	}
+
+	return hash;
+}
+
+} // namespace detail
+
+// Frame layout used by writeFrame/readFrame: 4 byte little endian
+// payload length, 4 byte little endian fnv-1a checksum of the payload
+// (0 when written without checksum), then the payload itself.
+constexpr std::size_t frameHeaderSize = 8;
+
+// Appends the given payload as a length-prefixed frame.
+// Works for WriteBuf and DynWriteBuf destinations.
+// The payload must fit the 32-bit length prefix.
+template<typename B>
+void writeFrame(B& dst, ReadBuf payload, bool checksum = true) {
+	NYTL_BYTES_ASSERT(payload.size() <=
+		std::numeric_limits<std::uint32_t>::max());
+	writeLE(dst, std::uint32_t(payload.size()));
+	writeLE(dst, checksum ? detail::fnv1a32(payload) : std::uint32_t {0});
+	write(dst, payload);
+}
+
+enum class FrameResult {
+	ok, // payload extracted, src advanced past the frame
+	incomplete, // src does not (yet) hold the whole frame, src unchanged
+	corrupt, // checksum mismatch, src unchanged
+};
+
+// Extracts the next frame from src.
+// On success, payload aliases the frame contents inside src (zero
+// copy) and src is advanced past the frame; on incomplete or corrupt
+// both buffers are left unchanged, i.e. a stream reader can just
+// retry once more data arrived. Combined with readView and skip this
+// allows picking single fields out of a large framed message without
+// copying or even touching the rest of it. Frames written without
+// checksum are never reported corrupt; pass validate = false to skip
+// validation entirely.
+inline FrameResult readFrame(ReadBuf& src, ReadBuf& payload,
+		bool validate = true) {
+	if(src.size() < frameHeaderSize) {
+		return FrameResult::incomplete;
+	}
+
+	auto peek = src;
+	auto length = readLE<std::uint32_t>(peek);
+	auto checksum = readLE<std::uint32_t>(peek);
+	if(peek.size() < length) {
+		return FrameResult::incomplete;
+	}
+
+	auto data = peek.first(length);
+	if(validate && checksum != 0u && detail::fnv1a32(data) != checksum) {
+		return FrameResult::corrupt;
+	}
+
+	payload = data;
+	src = peek.last(peek.size() - length);
+	return FrameResult::ok;
+}
+
+// One entry of a scatter-gather list, layout-compatible with the
+// posix iovec struct (modulo constness), so a segment span can be
+// passed to writev-style apis via reinterpret_cast.
+struct GatherSegment {
+	const void* base;
+	std::size_t length;
+};
+
+// Scatter-gather alternative to DynWriteBuf for vectored I/O.
+// Small writes are copied into one internal buffer and coalesced,
+// large spans are only recorded as (pointer, length) segments, so
+// bulk payloads are not memcpy'd a second time before submission.
+// The caller must keep referenced data alive until the segments
+// were consumed. Same free write() interface as the other buffers.
+class GatherWriteBuf {
+public:
+	// writes of at least this many bytes are referenced, not copied
+	static constexpr std::size_t defaultCopyThreshold = 64;
+
+public:
+	GatherWriteBuf(std::size_t copyThreshold = defaultCopyThreshold)
+		: threshold_(copyThreshold) {}
+
+	// Appends the given data, copying below the threshold and
+	// referencing above it.
+	void write(ReadBuf src) {
+		if(src.size() >= threshold_) {
+			writeRef(src);
+		} else {
+			writeCopy(src);
+		}
+	}
+
+	// Appends a reference to the given data, regardless of its size.
+	void writeRef(ReadBuf src) {
+		if(src.empty()) {
+			return;
+		}
+
+		segments_.push_back({src.data(), 0u, src.size()});
+		size_ += src.size();
+	}
+
+	// Appends a copy of the given data, regardless of its size.
+	// Adjacent copies are coalesced into one segment.
+	void writeCopy(ReadBuf src) {
+		if(src.empty()) {
+			return;
+		}
+
+		if(!segments_.empty() && !segments_.back().data &&
+				segments_.back().offset + segments_.back().length == copies_.size()) {
+			segments_.back().length += src.size();
+		} else {
+			segments_.push_back({nullptr, copies_.size(), src.size()});
+		}
+
+		nytl::write(copies_, src);
+		size_ += src.size();
+	}
+
+	// The recorded segments, in write order, e.g. for writev.
+	// Valid until the next write into this buffer.
+	span<const GatherSegment> segments() {
+		iov_.resize(segments_.size());
+		for(auto i = std::size_t {0}; i < segments_.size(); ++i) {
+			auto& seg = segments_[i];
+			iov_[i] = {seg.data ? seg.data : copies_.data() + seg.offset,
+				seg.length};
+		}
+
+		return iov_;
+	}
+
+	// Flattens all segments into one contiguous buffer, for code
+	// paths without vectored submission.
+	DynWriteBuf gather() const {
+		DynWriteBuf ret;
+		ret.reserve(size_);
+		for(auto& seg : segments_) {
+			auto base = seg.data ? seg.data : copies_.data() + seg.offset;
+			nytl::write(ret, ReadBuf {base, seg.length});
+		}
+
+		return ret;
+	}
+
+	// Total payload size over all segments, in bytes.
+	std::size_t size() const { return size_; }
+	bool empty() const { return size_ == 0; }
+
+	void clear() {
+		segments_.clear();
+		copies_.clear();
+		iov_.clear();
+		size_ = 0;
+	}
+
+protected:
+	// data == nullptr marks a copied segment at 'offset' into copies_;
+	// pointers into copies_ are resolved lazily in segments() since
+	// the vector may still grow.
+	struct Segment {
+		const std::byte* data;
+		std::size_t offset;
+		std::size_t length;
+	};
+
+	std::vector<Segment> segments_;
+	DynWriteBuf copies_;
+	std::vector<GatherSegment> iov_;
+	std::size_t size_ {};
+	std::size_t threshold_;
+};
+
+template<typename T>
+void write(GatherWriteBuf& dst, const T& obj) {
+	dst.write(ReadBuf(bytes(obj)));
+}
+
+// Chunked write buffer backed by a pmr memory resource.
+// Grows by appending fixed-size pages instead of reallocating, so
+// already serialized data is never copied on growth and pooling
+// resources can recycle the pages. For consumption, the filled
+// pages are exposed individually or flattened via copyTo().
+// Same free write() interface as the other buffers.
+class ArenaWriteBuf {
+public:
+	static constexpr std::size_t defaultPageSize = 16 * 1024;
+
+public:
+	ArenaWriteBuf(std::size_t pageSize = defaultPageSize,
+		std::pmr::memory_resource* memory = std::pmr::get_default_resource())
+			: memory_(memory), pageSize_(pageSize) {}
+
+	~ArenaWriteBuf() {
+		release();
+	}
+
+	ArenaWriteBuf(ArenaWriteBuf&& rhs) noexcept :
+			memory_(rhs.memory_), pages_(std::move(rhs.pages_)),
+			pageSize_(rhs.pageSize_), size_(rhs.size_) {
+		rhs.pages_.clear();
+		rhs.size_ = 0;
+	}
+
+	ArenaWriteBuf& operator=(ArenaWriteBuf&& rhs) noexcept {
+		release();
+		memory_ = rhs.memory_;
+		pages_ = std::move(rhs.pages_);
+		pageSize_ = rhs.pageSize_;
+		size_ = rhs.size_;
+		rhs.pages_.clear();
+		rhs.size_ = 0;
+		return *this;
+	}
+
+	// Appends the given data, splitting it across pages as needed.
+	void write(ReadBuf src) {
+		while(!src.empty()) {
+			auto used = size_ % pageSize_;
+			if(used == 0 && size_ == pages_.size() * pageSize_) {
+				auto mem = memory_->allocate(pageSize_, alignof(std::max_align_t));
+				pages_.push_back(static_cast<std::byte*>(mem));
+			}
+
+			auto page = pages_[size_ / pageSize_];
+			auto count = std::min(src.size(), pageSize_ - used);
+			std::memcpy(page + used, src.data(), count);
+			size_ += count;
+			skip(src, count);
+		}
+	}
+
+	// The filled part of the given page. Empty for pages that were
+	// retained by clear() but not written to again.
+	ReadBuf page(std::size_t i) const {
+		NYTL_BYTES_ASSERT(i < pages_.size());
+		if(i * pageSize_ >= size_) {
+			return {pages_[i], std::size_t(0)};
+		}
+
+		auto filled = std::min(size_ - i * pageSize_, pageSize_);
+		return {pages_[i], filled};
+	}
+
+	std::size_t pageCount() const { return pages_.size(); }
+	std::size_t pageSize() const { return pageSize_; }
+
+	// Copies all written data into the given contiguous buffer.
+	void copyTo(WriteBuf dst) const {
+		NYTL_BYTES_ASSERT(dst.size() >= size_);
+		auto used = (size_ + pageSize_ - 1) / pageSize_;
+		for(auto i = std::size_t {0}; i < used; ++i) {
+			nytl::write(dst, page(i));
+		}
+	}
+
+	// Total written size over all pages, in bytes.
+	std::size_t size() const { return size_; }
+	bool empty() const { return size_ == 0; }
+
+	// Resets the write position, the allocated pages are kept.
+	void clear() { size_ = 0; }
+
+	// Returns all pages to the memory resource.
+	void release() {
+		for(auto page : pages_) {
+			memory_->deallocate(page, pageSize_, alignof(std::max_align_t));
+		}
+
+		pages_.clear();
+		size_ = 0;
+	}
+
+protected:
+	std::pmr::memory_resource* memory_;
+	std::vector<std::byte*> pages_;
+	std::size_t pageSize_;
+	std::size_t size_ {};
+};
+
+template<typename T>
+void write(ArenaWriteBuf& dst, const T& obj) {
+	dst.write(ReadBuf(bytes(obj)));
+}
+
 // Example for writing a fixed-size data segment:
 //
 // WriteBuf dst;
@@ -12,8 +12,11 @@
 #include <nytl/connection.hpp> // nytl::BasicConnection
 #include <nytl/nonCopyable.hpp> // nytl::NonCopyable
 #include <nytl/scope.hpp> // nytl::ScopeGuard
+#include <nytl/delegate.hpp> // nytl::Delegate
+#include <nytl/span.hpp> // nytl::span
 
 #include <functional> // std::function
+#include <algorithm> // std::remove_if
 #include <utility> // std::move
 #include <cstdint> // std::uint64_t
 #include <cstddef> // std::size_t
@@ -43,8 +46,12 @@ namespace nytl {
 /// \tparam Signature The signature of the registered functions.
 /// Uses the same syntax and semantics as std::function.
 /// \tparam ID A connectionID class, see nytl/connection.hpp for examples.
+/// \tparam F The functor type used to store the registered functions.
+/// std::function by default, can e.g. be set to nytl::Delegate to keep
+/// small listener captures inline in the subscription vector.
 /// See docs/callback.md for specification.
-template<typename Signature, typename ID = ConnectionID>
+template<typename Signature, typename ID = ConnectionID,
+	typename F = std::function<Signature>>
 class Callback;
 
 /// Callback class typedef using TrackedConnectionID. Enables connections
@@ -53,9 +60,17 @@ class Callback;
 template<typename Signature> using TrackedCallback =
 	Callback<Signature, TrackedConnectionID>;
 
+/// Callback class typedef that stores its listeners in a small-buffer
+/// optimized, rtti-free nytl::Delegate instead of std::function.
+/// Typical lambda captures then stay inline in the subscription vector,
+/// making emission a linear, cache-friendly walk.
+template<typename Signature, std::size_t BufSize = 32>
+using DelegateCallback = Callback<Signature, ConnectionID,
+	Delegate<Signature, BufSize>>;
+
 // Callback specialization to enable the Ret(Args...) Signature format.
-template<typename Ret, typename... Args, typename ID>
-class Callback<Ret(Args...), ID>
+template<typename Ret, typename... Args, typename ID, typename F>
+class Callback<Ret(Args...), ID, F>
 	: public ConnectableT<ID>, public NonCopyable {
 public:
 	/// ! Definition not present in RecursiveCallback
@@ -65,7 +80,7 @@ public:
 	/// remove subscriptions from the outside without actively
 	/// calling disconnect.
 	struct Subscription {
-		std::function<Ret(Args...)> func;
+		F func;
 		ID id;
 	};
 
@@ -80,7 +95,7 @@ public:
 	/// \returns A connection id for the registered function which can be used to
 	/// unregister it.
 	/// \throws std::invalid_argument If an empty function target is registered.
-	Connection add(std::function<Ret(Args...)>);
+	Connection add(F);
 
 	/// Calls all registered functions and returns a vector with the returned objects,
 	/// or void when this is a void callback.
@@ -102,17 +117,23 @@ public:
 	/// callback is undefined behvaiour.
 	bool disconnect(const ID&) noexcept override;
 
+	/// Removes all callback functions registered with the given ids in
+	/// one compaction pass over the subscription vector instead of one
+	/// erase per id. Invalid or already removed ids are simply skipped.
+	/// Returns the number of functions that were actually removed.
+	std::size_t disconnect(span<const ID> ids) noexcept override;
+
 	/// Operator version of add
-	template<typename F>
-	Connection operator+=(F&& func) {
-		return add(std::forward<F>(func));
+	template<typename O>
+	Connection operator+=(O&& func) {
+		return add(std::forward<O>(func));
 	}
 
 	/// Operator version of add that previously calls clear.
-	template<typename F>
-	Connection operator=(F&& func) {
+	template<typename O>
+	Connection operator=(O&& func) {
 		clear();
-		return add(std::forward<F>(func));
+		return add(std::forward<O>(func));
 	}
 
 	/// Operator version of call.
@@ -120,6 +141,43 @@ public:
 		return call(std::forward<Args>(a)...);
 	}
 
+	/// ! Not present in RecursiveCallback
+	/// Like call, but writes the returned objects into the given span
+	/// instead of allocating a vector. At most results.size() values are
+	/// written, all registered functions are called either way.
+	/// Returns the number of written results.
+	/// Only available for callbacks with non-void return type.
+	template<typename R = Ret,
+		typename = std::enable_if_t<!std::is_same_v<R, void>>>
+	std::size_t callInto(span<Ret> results, Args... a) {
+		auto count = std::size_t {0};
+		for(auto& sub : subs_) {
+			if(count < results.size()) {
+				results[count++] = sub.func(std::forward<Args>(a)...);
+			} else {
+				sub.func(std::forward<Args>(a)...);
+			}
+		}
+
+		return count;
+	}
+
+	/// ! Not present in RecursiveCallback
+	/// Like call, but combines the returned objects with the given
+	/// reducer instead of materializing them, i.e. never allocates.
+	/// The reducer is invoked as `state = reduce(std::move(state), result)`
+	/// for every registered function, the final state is returned.
+	/// Only available for callbacks with non-void return type.
+	template<typename T, typename Reduce, typename R = Ret,
+		typename = std::enable_if_t<!std::is_same_v<R, void>>>
+	T callFold(T state, Reduce reduce, Args... a) {
+		for(auto& sub : subs_) {
+			state = reduce(std::move(state), sub.func(std::forward<Args>(a)...));
+		}
+
+		return state;
+	}
+
 	/// ! Not present in RecursiveCallback
 	/// Returns the internal vector of registered subscriptions
 	/// Can be used to e.g. call it more efficiently (without creating a vector) or
@@ -134,17 +192,17 @@ protected:
 };
 
 // - implementation
-template<typename Ret, typename... Args, typename ID>
-Callback<Ret(Args...), ID>::~Callback()
+template<typename Ret, typename... Args, typename ID, typename F>
+Callback<Ret(Args...), ID, F>::~Callback()
 {
 	for(auto& sub : subs_) {
 		sub.id.removed();
 	}
 }
 
-template<typename Ret, typename... Args, typename ID>
-ConnectionT<ConnectableT<ID>, ID> Callback<Ret(Args...), ID>::
-add(std::function<Ret(Args...)> func) {
+template<typename Ret, typename... Args, typename ID, typename F>
+ConnectionT<ConnectableT<ID>, ID> Callback<Ret(Args...), ID, F>::
+add(F func) {
 	if(!func) {
 		throw std::invalid_argument("nytl::Callback::add: empty function");
 	}
@@ -167,8 +225,8 @@ add(std::function<Ret(Args...)> func) {
 	return {*this, id};
 }
 
-template<typename Ret, typename... Args, typename ID>
-auto Callback<Ret(Args...), ID>::call(Args... a)
+template<typename Ret, typename... Args, typename ID, typename F>
+auto Callback<Ret(Args...), ID, F>::call(Args... a)
 {
 	// the first continue check is needed to not call functions that were
 	// removed before this call started but call functions that were removed
@@ -188,8 +246,8 @@ auto Callback<Ret(Args...), ID>::call(Args... a)
 	}
 }
 
-template<typename Ret, typename... Args, typename ID>
-void Callback<Ret(Args...), ID>::clear() noexcept
+template<typename Ret, typename... Args, typename ID, typename F>
+void Callback<Ret(Args...), ID, F>::clear() noexcept
 {
 	// notify the ids of removal
 	for(auto& sub : subs_) {
@@ -198,8 +256,8 @@ void Callback<Ret(Args...), ID>::clear() noexcept
 	subs_.clear();
 }
 
-template<typename Ret, typename... Args, typename ID>
-bool Callback<Ret(Args...), ID>::disconnect(const ID& id) noexcept
+template<typename Ret, typename... Args, typename ID, typename F>
+bool Callback<Ret(Args...), ID, F>::disconnect(const ID& id) noexcept
 {
 	constexpr auto pred = [](const auto& s1, const auto& s2) {
 		return s1.id.get() < s2.id.get();
@@ -218,6 +276,26 @@ bool Callback<Ret(Args...), ID>::disconnect(const ID& id) noexcept
 	return true;
 }
 
+template<typename Ret, typename... Args, typename ID, typename F>
+std::size_t Callback<Ret(Args...), ID, F>::disconnect(span<const ID> ids) noexcept
+{
+	auto count = std::size_t {0};
+	auto end = std::remove_if(subs_.begin(), subs_.end(), [&](auto& sub) {
+		for(auto& id : ids) {
+			if(id.get() != 0 && sub.id.get() == id.get()) {
+				sub.id.removed();
+				++count;
+				return true;
+			}
+		}
+
+		return false;
+	});
+
+	subs_.erase(end, subs_.end());
+	return count;
+}
+
 } // namespace nytl
 
 #endif // header guard
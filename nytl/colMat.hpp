@@ -0,0 +1,245 @@
+// Copyright (c) 2017-2020 nyorain
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt
+
+/// \file Defines the column-major nytl::ColMat matrix class.
+
+#pragma once
+
+#ifndef NYTL_INCLUDE_COL_MAT
+#define NYTL_INCLUDE_COL_MAT
+
+#include <nytl/mat.hpp> // nytl::Mat
+#include <nytl/vec.hpp> // nytl::Vec
+#include <nytl/vecOps.hpp> // nytl::dot
+
+namespace nytl {
+
+/// The same logical matrix as nytl::Mat, but stored column-major,
+/// i.e. in the memory layout graphics apis consume. Matrices that are
+/// eventually uploaded can live in this type their whole life (all
+/// operators below keep the layout), which removes the
+/// transpose-and-copy pass otherwise needed before bytes.hpp write()
+/// can upload row-major Mats.
+/// Unlike Mat, operator[] is *not* row access; use the explicit
+/// row()/col()/operator() accessors.
+/// - T: The value type of the matrix.
+/// - R: The rows of the matrix.
+/// - C: The columns of the matrix.
+template<size_t R, size_t C, typename T>
+struct ColMat {
+	/// The (static/fixed) dimensions of the matrix
+	static constexpr auto rows() { return R; }
+	static constexpr auto cols() { return C; }
+
+public:
+	/// Returns the value at position (r, c).
+	constexpr auto& operator()(size_t r, size_t c) { return cols_[c][r]; }
+	constexpr const auto& operator()(size_t r, size_t c) const { return cols_[c][r]; }
+
+	/// Returns the ith column of the matrix, the contiguous direction
+	/// of this layout.
+	constexpr auto& col(size_t i) { return cols_[i]; }
+	constexpr const auto& col(size_t i) const { return cols_[i]; }
+
+	/// Returns a copy of the ith row of the matrix.
+	/// Rows are not contiguous in this layout, so only value access
+	/// is possible.
+	constexpr Vec<C, T> row(size_t i) const {
+		Vec<C, T> ret {};
+		for(auto c = 0u; c < C; ++c) {
+			ret[c] = cols_[c][i];
+		}
+
+		return ret;
+	}
+
+	/// Returns the value at position (r, c).
+	/// If this position exceeds the size of the matrix, throws std::out_of_range.
+	constexpr auto& at(size_t r, size_t c) { check(r, c); return cols_[c][r]; }
+	constexpr const auto& at(size_t r, size_t c) const { check(r, c); return cols_[c][r]; }
+
+	/// Explicitly casts the ColMat to another ColMat that may have
+	/// a different precision or dimensions, like the Mat cast operator.
+	template<size_t OR, size_t OC, typename OT>
+	constexpr explicit operator ColMat<OR, OC, OT>() const {
+		ColMat<OR, OC, OT> ret {};
+		for(auto c = 0u; c < std::min(C, OC); ++c)
+			for(auto r = 0u; r < std::min(R, OR); ++r)
+				ret(r, c) = (*this)(r, c);
+		return ret;
+	}
+
+	/// Utility function that throws std::out_of_range if the matrix does not
+	/// have the given position.
+	constexpr void check(size_t r, size_t c) const {
+		if(r >= rows() || c >= cols())
+			throw std::out_of_range("nytl::ColMat::at");
+	}
+
+public:
+	std::array<Vec<R, T>, C> cols_;
+};
+
+template<typename T> using ColMat2 = ColMat<2, 2, T>;
+template<typename T> using ColMat3 = ColMat<3, 3, T>;
+template<typename T> using ColMat4 = ColMat<4, 4, T>;
+
+using ColMat2f = ColMat2<float>;
+using ColMat3f = ColMat3<float>;
+using ColMat4f = ColMat4<float>;
+using ColMat2d = ColMat2<double>;
+using ColMat3d = ColMat3<double>;
+using ColMat4d = ColMat4<double>;
+
+// - conversions -
+// Converting between the layouts transposes the storage (not the
+// logical matrix) exactly once; done at creation time, e.g. right
+// after a transform.hpp builder, all further arithmetic stays in
+// upload layout.
+template<size_t R, size_t C, typename T>
+constexpr ColMat<R, C, T> colMajor(const Mat<R, C, T>& m) {
+	ColMat<R, C, T> ret {};
+	for(auto r = 0u; r < R; ++r)
+		for(auto c = 0u; c < C; ++c)
+			ret(r, c) = m[r][c];
+	return ret;
+}
+
+template<size_t R, size_t C, typename T>
+constexpr Mat<R, C, T> rowMajor(const ColMat<R, C, T>& m) {
+	Mat<R, C, T> ret {};
+	for(auto c = 0u; c < C; ++c)
+		for(auto r = 0u; r < R; ++r)
+			ret[r][c] = m(r, c);
+	return ret;
+}
+
+// - operators -
+// mat * mat
+// Mirror image of the Mat operator*: every result column is a linear
+// combination of the columns of a, so both matrices are again walked
+// sequentially in memory and the inner loop is a pure multiply-add
+// over a column.
+template<typename T1, typename T2, size_t R, size_t M, size_t C>
+constexpr auto operator*(const ColMat<R, M, T1>& a, const ColMat<M, C, T2>& b) {
+	ColMat<R, C, decltype(a(0, 0) * b(0, 0) + a(0, 0) * b(0, 0))> ret {};
+	for(auto c = 0u; c < C; ++c) // ret: cols
+		for(auto i = 0u; i < M; ++i) // col of a
+			for(auto r = 0u; r < R; ++r) // ret: rows
+				ret(r, c) += a(r, i) * b(i, c);
+	return ret;
+}
+
+// mat * vec
+template<typename T1, typename T2, size_t R, size_t C>
+constexpr auto operator*(const ColMat<R, C, T1>& a, const Vec<C, T2>& b) {
+	Vec<R, decltype(a(0, 0) * b[0] + a(0, 0) * b[0])> ret {};
+	for(auto c = 0u; c < C; ++c)
+		for(auto r = 0u; r < R; ++r)
+			ret[r] += a(r, c) * b[c];
+	return ret;
+}
+
+// mat *= mat (quadratic)
+template<typename T1, typename T2, size_t D>
+constexpr auto& operator*=(ColMat<D, D, T1>& a, const ColMat<D, D, T2>& b) {
+	a = a * b;
+	return a;
+}
+
+// fac * mat
+template<typename F, typename T, size_t R, size_t C>
+constexpr auto operator*(const F& f, const ColMat<R, C, T>& a) {
+	ColMat<R, C, decltype(f * a(0, 0))> ret {};
+	for(auto c = 0u; c < C; ++c)
+		ret.col(c) = f * a.col(c);
+	return ret;
+}
+
+// mat *= fac
+template<typename F, typename T, size_t R, size_t C>
+constexpr auto& operator*=(ColMat<R, C, T>& a, const F& f) {
+	for(auto c = 0u; c < C; ++c)
+		a.col(c) *= f;
+	return a;
+}
+
+// mat + mat
+template<typename T1, typename T2, size_t R, size_t C>
+constexpr auto operator+(const ColMat<R, C, T1>& a, const ColMat<R, C, T2>& b) {
+	ColMat<R, C, decltype(a(0, 0) + b(0, 0))> ret {};
+	for(auto c = 0u; c < C; ++c)
+		ret.col(c) = a.col(c) + b.col(c);
+	return ret;
+}
+
+// mat += mat
+template<typename T1, typename T2, size_t R, size_t C>
+constexpr auto& operator+=(ColMat<R, C, T1>& a, const ColMat<R, C, T2>& b) {
+	for(auto c = 0u; c < C; ++c)
+		a.col(c) += b.col(c);
+	return a;
+}
+
+// mat - mat
+template<typename T1, typename T2, size_t R, size_t C>
+constexpr auto operator-(const ColMat<R, C, T1>& a, const ColMat<R, C, T2>& b) {
+	ColMat<R, C, decltype(a(0, 0) - b(0, 0))> ret {};
+	for(auto c = 0u; c < C; ++c)
+		ret.col(c) = a.col(c) - b.col(c);
+	return ret;
+}
+
+// mat -= mat
+template<typename T1, typename T2, size_t R, size_t C>
+constexpr auto& operator-=(ColMat<R, C, T1>& a, const ColMat<R, C, T2>& b) {
+	for(auto c = 0u; c < C; ++c)
+		a.col(c) -= b.col(c);
+	return a;
+}
+
+// -mat
+template<typename T, size_t R, size_t C>
+constexpr auto operator-(ColMat<R, C, T> a) {
+	for(auto c = 0u; c < C; ++c)
+		a.col(c) = -a.col(c);
+	return a;
+}
+
+template<typename T1, typename T2, size_t R, size_t C>
+constexpr auto operator==(const ColMat<R, C, T1>& a, const ColMat<R, C, T2>& b) {
+	for(auto i = 0u; i < C; ++i)
+		if(a.cols_[i] != b.cols_[i])
+			return false;
+	return true;
+}
+
+template<typename T1, typename T2, size_t R, size_t C>
+constexpr auto operator!=(const ColMat<R, C, T1>& a, const ColMat<R, C, T2>& b) {
+	return !(a == b);
+}
+
+// Transposition swaps the dimensions and reinterprets the storage,
+// i.e. is free modulo the copy.
+template<size_t R, size_t C, typename T>
+constexpr auto transpose(const ColMat<R, C, T>& a) {
+	ColMat<C, R, T> ret {};
+	for(auto c = 0u; c < C; ++c)
+		for(auto r = 0u; r < R; ++r)
+			ret(c, r) = a(r, c);
+	return ret;
+}
+
+/// Returns the identity matrix, like nytl::identity for Mat.
+template<size_t D, typename T>
+constexpr ColMat<D, D, T> colIdentity() {
+	ColMat<D, D, T> ret {};
+	for(auto i = 0u; i < D; ++i)
+		ret(i, i) = T {1};
+	return ret;
+}
+
+} // namespace nytl
+
+#endif // header guard
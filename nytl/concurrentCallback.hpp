@@ -0,0 +1,252 @@
+// Copyright (c) 2017-2020 nyorain
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt
+
+/// \file Defines the ConcurrentCallback template class.
+
+#pragma once
+
+#ifndef NYTL_INCLUDE_CONCURRENT_CALLBACK
+#define NYTL_INCLUDE_CONCURRENT_CALLBACK
+
+#include <nytl/connection.hpp> // nytl::BasicConnection
+#include <nytl/nonCopyable.hpp> // nytl::NonCopyable
+
+#include <functional> // std::function
+#include <utility> // std::move
+#include <atomic> // std::atomic
+#include <memory> // std::shared_ptr
+#include <cstdint> // std::uint64_t
+#include <cstddef> // std::size_t
+#include <type_traits> // std::is_same
+#include <vector> // std::vector
+#include <stdexcept> // std::invalid_argument
+
+namespace nytl {
+
+/// Thread-safe variant of nytl::Callback for cross-thread event delivery.
+/// The public interface matches nytl::Callback (see docs/callback.md) so
+/// the classes can be used interchangeably, but all operations may be
+/// performed concurrently from multiple threads.
+/// Subscriptions are kept in an immutable list published through an
+/// atomic shared_ptr (read-copy-update): call() just loads a snapshot
+/// and iterates it without taking any lock, while add(), disconnect()
+/// and clear() build a new list and swap it in with a CAS loop.
+/// This makes emission cheap and modification lock-free but relatively
+/// expensive (a full copy of the subscription list), i.e. the class is
+/// meant for callbacks that are called much more often than modified.
+/// Note the snapshot semantics: a function disconnected from another
+/// thread might still be invoked by an emission that already started,
+/// disconnect() does not wait for such emissions to finish. If the ID
+/// type has observable state (e.g. TrackedConnectionID), it must itself
+/// be safe to access from multiple threads.
+/// All exceptions from calls are just propagated.
+/// The class can not be copied or moved.
+///
+/// \tparam Signature The signature of the registered functions.
+/// Uses the same syntax and semantics as std::function.
+/// \tparam ID A connectionID class, see nytl/connection.hpp for examples.
+/// See docs/callback.md for specification.
+template<typename Signature, typename ID = ConnectionID>
+class ConcurrentCallback;
+
+// Callback specialization to enable the Ret(Args...) Signature format.
+template<typename Ret, typename... Args, typename ID>
+class ConcurrentCallback<Ret(Args...), ID>
+	: public ConnectableT<ID>, public NonCopyable {
+public:
+	using Signature = Ret(Args...);
+	using Connection = ConnectionT<ConnectableT<ID>, ID>;
+
+	ConcurrentCallback() : subs_(std::make_shared<SubList>()) {}
+	~ConcurrentCallback();
+
+	/// \brief Registers a new Callback function.
+	/// \returns A connection id for the registered function which can be used to
+	/// unregister it.
+	/// \throws std::invalid_argument If an empty function target is registered.
+	Connection add(std::function<Ret(Args...)>);
+
+	/// Calls all registered functions and returns a vector with the returned objects,
+	/// or void when this is a void callback.
+	/// Will call all the functions registered at the moment of calling, i.e.
+	/// concurrent modifications don't affect this emission.
+	/// If a registered function throws, the exception is not caught, i.e. the
+	/// following handlers will not be called.
+	auto call(Args...);
+
+	/// Clears all registered functions.
+	/// Functions currently being called from other threads finish normally.
+	void clear() noexcept;
+
+	/// Removes the callback function registered with the given id.
+	/// Returns whether the function could be found. If the id is invalid or the
+	/// associated function was already removed, returns false.
+	/// Prefer to use this indirectly using some Connection object.
+	/// Emissions that already started on other threads might still call the
+	/// function, this is not waited upon.
+	bool disconnect(const ID&) noexcept override;
+
+	/// The inherited bulk overload, would otherwise be name-hidden.
+	using ConnectableT<ID>::disconnect;
+
+	/// Operator version of add
+	template<typename F>
+	Connection operator+=(F&& func) {
+		return add(std::forward<F>(func));
+	}
+
+	/// Operator version of add that previously calls clear.
+	template<typename F>
+	Connection operator=(F&& func) {
+		clear();
+		return add(std::forward<F>(func));
+	}
+
+	/// Operator version of call.
+	auto operator() (Args... a) {
+		return call(std::forward<Args>(a)...);
+	}
+
+protected:
+	// Represents one callback subscription entry.
+	// Entries are immutable once published, modification always
+	// publishes a whole new list.
+	struct Subscription {
+		std::function<Ret(Args...)> func;
+		ID id;
+	};
+
+	using SubList = std::vector<Subscription>;
+
+	// Publishes the list returned by `edit(oldList)` via a CAS loop.
+	// edit may be called multiple times (when another thread won the
+	// race) and may return nullptr to signal that there is nothing
+	// to change for the current list.
+	template<typename Edit>
+	std::shared_ptr<const SubList> update(Edit edit) {
+		auto old = std::atomic_load(&subs_);
+		while(true) {
+			auto next = edit(*old);
+			if(!next) {
+				return nullptr;
+			}
+
+			if(std::atomic_compare_exchange_weak(&subs_, &old,
+					std::shared_ptr<const SubList>(std::move(next)))) {
+				return old;
+			}
+		}
+	}
+
+	std::shared_ptr<const SubList> subs_; // current, immutable subscription list
+	std::atomic<std::int64_t> subID_ {}; // the highest subscription id given
+};
+
+// - implementation
+template<typename Ret, typename... Args, typename ID>
+ConcurrentCallback<Ret(Args...), ID>::~ConcurrentCallback()
+{
+	auto subs = std::atomic_load(&subs_);
+	for(auto& sub : *subs) {
+		// id is notified only here; the list itself may outlive the
+		// callback in concurrent emissions but is never accessed
+		// through it anymore
+		const_cast<ID&>(sub.id).removed();
+	}
+}
+
+template<typename Ret, typename... Args, typename ID>
+ConnectionT<ConnectableT<ID>, ID> ConcurrentCallback<Ret(Args...), ID>::
+add(std::function<Ret(Args...)> func) {
+	if(!func) {
+		throw std::invalid_argument("nytl::ConcurrentCallback::add: empty function");
+	}
+
+	ID id = {subID_.fetch_add(1) + 1};
+	update([&](const SubList& old) {
+		auto next = std::make_shared<SubList>(old);
+		next->push_back({func, id});
+		return next;
+	});
+
+	return {*this, id};
+}
+
+template<typename Ret, typename... Args, typename ID>
+auto ConcurrentCallback<Ret(Args...), ID>::call(Args... a)
+{
+	// the snapshot keeps all called functions alive, even if they
+	// are disconnected or the whole callback cleared from another
+	// thread in the meantime
+	auto subs = std::atomic_load(&subs_);
+
+	if constexpr(std::is_same<Ret, void>::value) {
+		for(auto& sub : *subs) {
+			sub.func(std::forward<Args>(a)...);
+		}
+	} else {
+		std::vector<Ret> ret;
+		ret.reserve(subs->size());
+
+		for(auto& sub : *subs) {
+			ret.push_back(sub.func(std::forward<Args>(a)...));
+		}
+
+		return ret;
+	}
+}
+
+template<typename Ret, typename... Args, typename ID>
+void ConcurrentCallback<Ret(Args...), ID>::clear() noexcept
+{
+	auto old = update([&](const SubList& list) -> std::shared_ptr<SubList> {
+		if(list.empty()) {
+			return nullptr;
+		}
+
+		return std::make_shared<SubList>();
+	});
+
+	// notify the ids of removal; only this thread still references them
+	if(old) {
+		for(auto& sub : *old) {
+			const_cast<ID&>(sub.id).removed();
+		}
+	}
+}
+
+template<typename Ret, typename... Args, typename ID>
+bool ConcurrentCallback<Ret(Args...), ID>::disconnect(const ID& id) noexcept
+{
+	auto found = false;
+	update([&](const SubList& old) -> std::shared_ptr<SubList> {
+		found = false;
+		auto next = std::make_shared<SubList>();
+		next->reserve(old.size());
+		for(auto& sub : old) {
+			if(!found && sub.id.get() == id.get()) {
+				found = true;
+			} else {
+				next->push_back(sub);
+			}
+		}
+
+		if(!found) {
+			return nullptr;
+		}
+
+		return next;
+	});
+
+	if(found) {
+		ID copy = id;
+		copy.removed();
+	}
+
+	return found;
+}
+
+} // namespace nytl
+
+#endif // header guard
@@ -9,9 +9,15 @@
 #ifndef NYTL_INCLUDE_CONNECTION
 #define NYTL_INCLUDE_CONNECTION
 
+#include <nytl/span.hpp> // nytl::span
+
 #include <iostream> // std::cerr
 #include <exception> // std::exception
 #include <memory> // std::shared_ptr
+#include <vector> // std::vector
+#include <cstdint> // std::uint32_t
+#include <cstddef> // std::size_t
+#include <algorithm> // std::sort
 
 namespace nytl {
 
@@ -26,6 +32,20 @@ class ConnectableT {
 public:
 	virtual ~ConnectableT() = default;
 	virtual bool disconnect(const ID& id) = 0;
+
+	/// Disconnects all given connections at once.
+	/// The default implementation just disconnects them one by one,
+	/// implementations can override it with something cheaper than
+	/// repeated single-id removal (see nytl::Callback).
+	/// Returns the number of connections that were actually found.
+	virtual std::size_t disconnect(span<const ID> ids) {
+		auto count = std::size_t {0};
+		for(auto& id : ids) {
+			count += disconnect(id);
+		}
+
+		return count;
+	}
 };
 
 /// \brief Associates a BasicConnectable implementation with one of its connection ids.
@@ -160,6 +180,105 @@ protected:
 	ID id_ {};
 };
 
+/// \brief Owns a whole batch of connections.
+/// Does the job of one UniqueConnectionT per subscription, but stores
+/// the (connectable, id) pairs contiguously in a single vector and
+/// disconnects them in batches: on teardown the entries are grouped by
+/// target connectable and each target gets one bulk disconnect call
+/// instead of one virtual call per connection. Useful for objects
+/// holding many subscriptions (widgets, observers) whose teardown cost
+/// matters.
+/// Like UniqueConnectionT it does not track the lifetime of the
+/// connectables, they must outlive the set (or the set must be
+/// clear()ed before they go away).
+template<typename C, typename ID>
+class ConnectionSetT {
+public:
+	ConnectionSetT() = default;
+	~ConnectionSetT() {
+		try {
+			disconnect();
+		} catch(const std::exception& error) {
+			std::cerr << "nytl::~ConnectionSetT: disconnect failed: " << error.what() << "\n";
+		}
+	}
+
+	ConnectionSetT(ConnectionSetT&& lhs) noexcept
+		: entries_(std::move(lhs.entries_)) {
+		lhs.entries_.clear();
+	}
+
+	ConnectionSetT& operator=(ConnectionSetT&& lhs) noexcept {
+		disconnect();
+		entries_ = std::move(lhs.entries_);
+		lhs.entries_.clear();
+		return *this;
+	}
+
+	/// Takes ownership of the given connection.
+	/// Empty connections are ignored.
+	void add(ConnectionT<C, ID> conn) {
+		if(conn.connectable()) {
+			entries_.push_back({conn.connectable(), conn.id()});
+		}
+	}
+
+	void add(C& connectable, ID id) {
+		entries_.push_back({&connectable, id});
+	}
+
+	/// Operator version of add, mirroring Callback::operator+=.
+	ConnectionSetT& operator+=(ConnectionT<C, ID> conn) {
+		add(conn);
+		return *this;
+	}
+
+	/// Disconnects all owned connections and empties the set.
+	/// Groups the ids by connectable so every target receives a single
+	/// bulk disconnect call. Returns the number of connections that
+	/// were actually found by their connectables.
+	std::size_t disconnect() {
+		// group runs of the same target together, keeping the ids of
+		// a run in their original (insertion) order
+		std::stable_sort(entries_.begin(), entries_.end(),
+			[](const auto& a, const auto& b) {
+				return a.connectable < b.connectable;
+			});
+
+		auto count = std::size_t {0};
+		std::vector<ID> ids;
+		for(auto it = entries_.begin(); it != entries_.end();) {
+			auto* target = it->connectable;
+			ids.clear();
+			for(; it != entries_.end() && it->connectable == target; ++it) {
+				ids.push_back(it->id);
+			}
+
+			ConnectableT<ID>& c = *target;
+			count += c.disconnect(span<const ID>(ids.data(), ids.size()));
+		}
+
+		entries_.clear();
+		return count;
+	}
+
+	/// Drops all owned connections without disconnecting them.
+	void clear() noexcept {
+		entries_.clear();
+	}
+
+	[[nodiscard]] std::size_t size() const noexcept { return entries_.size(); }
+	[[nodiscard]] bool empty() const noexcept { return entries_.empty(); }
+
+protected:
+	struct Entry {
+		C* connectable;
+		ID id;
+	};
+
+	std::vector<Entry> entries_ {};
+};
+
 /// Default ID for a connection that is entirely defined over its value.
 struct ConnectionID {
 	std::int64_t value;
@@ -182,13 +301,88 @@ struct TrackedConnectionID {
 	void removed() noexcept { if(value) *value = 0; value.reset(); }
 };
 
+/// Tracks removal like TrackedConnectionID, but without allocating:
+/// instead of a shared_ptr control block per connection, the id holds
+/// a slot index plus a generation counter that is validated against a
+/// thread-local slot table. Releasing a slot bumps its generation,
+/// which invalidates all copies of the id at once; reusing the slot
+/// for a later connection hands out the new generation. No allocation
+/// (the table grows amortized) and no atomic refcount traffic on
+/// copies, but ids of this policy must stay on the thread that
+/// created them.
+struct SlotConnectionID {
+	std::int64_t value {};
+	std::uint32_t slot {};
+	std::uint32_t generation {}; // 0: empty id
+
+	SlotConnectionID() = default;
+	SlotConnectionID(std::int64_t val) : value(val) {
+		slot = slots().acquire();
+		generation = slots().generation(slot);
+	}
+
+	void set(std::int64_t val) noexcept { value = val; }
+
+	auto get() const noexcept {
+		return valid() ? value : std::int64_t {0};
+	}
+
+	void removed() noexcept {
+		if(valid()) {
+			slots().release(slot);
+		}
+	}
+
+	bool valid() const noexcept {
+		return generation != 0 && slots().generation(slot) == generation;
+	}
+
+protected:
+	struct Slots {
+		std::vector<std::uint32_t> generations;
+		std::vector<std::uint32_t> unused;
+
+		std::uint32_t acquire() {
+			if(!unused.empty()) {
+				auto slot = unused.back();
+				unused.pop_back();
+				return slot;
+			}
+
+			generations.push_back(1u);
+			return std::uint32_t(generations.size() - 1);
+		}
+
+		void release(std::uint32_t slot) {
+			++generations[slot];
+			unused.push_back(slot);
+		}
+
+		std::uint32_t generation(std::uint32_t slot) const {
+			return generations[slot];
+		}
+	};
+
+	static Slots& slots() noexcept {
+		static thread_local Slots slots;
+		return slots;
+	}
+};
+
 using Connectable = ConnectableT<ConnectionID>;
 using Connection = ConnectionT<Connectable, ConnectionID>;
 using UniqueConnection = UniqueConnectionT<Connectable, ConnectionID>;
+using ConnectionSet = ConnectionSetT<Connectable, ConnectionID>;
 
 using TrackedConnectable = ConnectableT<TrackedConnectionID>;
 using TrackedConnection = ConnectionT<TrackedConnectable, TrackedConnectionID>;
 using TrackedUniqueConnection = UniqueConnectionT<TrackedConnectable, TrackedConnectionID>;
+using TrackedConnectionSet = ConnectionSetT<TrackedConnectable, TrackedConnectionID>;
+
+using SlotConnectable = ConnectableT<SlotConnectionID>;
+using SlotConnection = ConnectionT<SlotConnectable, SlotConnectionID>;
+using SlotUniqueConnection = UniqueConnectionT<SlotConnectable, SlotConnectionID>;
+using SlotConnectionSet = ConnectionSetT<SlotConnectable, SlotConnectionID>;
 
 // TODO: remove
 /*
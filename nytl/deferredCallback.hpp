@@ -0,0 +1,126 @@
+// Copyright (c) 2017-2020 nyorain
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt
+
+/// \file Defines the DeferredCallback template class.
+
+#pragma once
+
+#ifndef NYTL_INCLUDE_DEFERRED_CALLBACK
+#define NYTL_INCLUDE_DEFERRED_CALLBACK
+
+#include <nytl/callback.hpp> // nytl::Callback
+#include <nytl/scope.hpp> // nytl::ScopeGuard
+
+#include <tuple> // std::tuple
+#include <utility> // std::move
+#include <vector> // std::vector
+#include <cstddef> // std::size_t
+#include <type_traits> // std::decay_t
+
+namespace nytl {
+
+/// \brief A Callback whose emissions are queued and dispatched in batches.
+/// Instead of walking the whole listener list for every single event,
+/// operator() just appends the argument tuple to a contiguous queue
+/// (no per-event allocation once the queue has grown to its working
+/// size). flush() then dispatches all queued events at once, walking
+/// the subscription list listener-major so each listener's code and
+/// captured data stay hot in cache across the whole batch.
+/// Useful when events are produced much more often than they need to
+/// be observed, e.g. many per frame.
+/// Inherits the full (single-threaded, non-recursive) Callback
+/// interface for subscription management; events enqueued from within
+/// a flush are dispatched by the next flush, not the running one.
+/// Only available for void signatures, deferred return values are not
+/// supported.
+///
+/// \tparam Signature The signature of the registered functions,
+/// must have a void return type. The decayed argument types are
+/// stored in the queue, so they must be copy- or move-constructible.
+/// \tparam ID A connectionID class, see nytl/connection.hpp.
+/// \tparam F The functor type used to store the registered functions.
+template<typename Signature, typename ID = ConnectionID,
+	typename F = std::function<Signature>>
+class DeferredCallback;
+
+// DeferredCallback specialization to enable the void(Args...) format.
+template<typename... Args, typename ID, typename F>
+class DeferredCallback<void(Args...), ID, F>
+	: public Callback<void(Args...), ID, F> {
+public:
+	using Event = std::tuple<std::decay_t<Args>...>;
+
+public:
+	/// Enqueues the given arguments for the next flush.
+	/// Shadows the immediately-dispatching Callback::operator().
+	void operator()(Args... a) {
+		enqueue(std::forward<Args>(a)...);
+	}
+
+	void enqueue(Args... a) {
+		queue_.emplace_back(std::forward<Args>(a)...);
+		if(queue_.size() > highWater_) {
+			highWater_ = queue_.size();
+		}
+	}
+
+	/// Dispatches all currently queued events to all registered
+	/// functions and empties the queue. Walks the subscription list
+	/// listener-major, i.e. each listener receives the whole batch
+	/// before the next one runs; the per-listener event order is the
+	/// enqueue order. Exceptions from listeners are propagated, the
+	/// batch still counts as consumed.
+	/// Returns the number of dispatched events.
+	std::size_t flush() {
+		if(queue_.empty()) {
+			return 0u;
+		}
+
+		// swap instead of iterating queue_ directly so that events
+		// enqueued by listeners land in the next batch; the buffers
+		// keep their capacity, i.e. steady-state flushing does not
+		// allocate
+		std::swap(queue_, active_);
+		auto count = active_.size();
+
+		// clear even when a listener throws, otherwise the next flush
+		// would swap the partially dispatched batch back in and
+		// re-dispatch it
+		auto consumedGuard = ScopeGuard([&]{
+			active_.clear();
+		});
+
+		for(auto& sub : this->subs_) {
+			for(auto& event : active_) {
+				std::apply(sub.func, event);
+			}
+		}
+
+		return count;
+	}
+
+	/// Discards all queued events without dispatching them.
+	void discard() noexcept {
+		queue_.clear();
+	}
+
+	/// The number of currently queued events.
+	[[nodiscard]] std::size_t pending() const noexcept {
+		return queue_.size();
+	}
+
+	/// The largest queue depth seen so far, for sizing/telemetry.
+	[[nodiscard]] std::size_t highWater() const noexcept {
+		return highWater_;
+	}
+
+protected:
+	std::vector<Event> queue_ {}; // events for the next flush
+	std::vector<Event> active_ {}; // batch being dispatched
+	std::size_t highWater_ {};
+};
+
+} // namespace nytl
+
+#endif // header guard
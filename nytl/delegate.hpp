@@ -0,0 +1,134 @@
+// Copyright (c) 2017-2020 nyorain
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt
+
+/// \file Defines the Delegate template class, a lightweight
+/// std::function alternative.
+
+#pragma once
+
+#ifndef NYTL_INCLUDE_DELEGATE
+#define NYTL_INCLUDE_DELEGATE
+
+#include <cstddef> // std::size_t
+#include <new> // std::launder
+#include <type_traits> // std::is_invocable
+#include <utility> // std::forward
+
+namespace nytl {
+
+/// A move-only callable wrapper with configurable inline storage.
+/// In difference to std::function, callables up to 'BufSize' bytes are
+/// stored inline (no allocation, no pointer chase on call) and there is
+/// no RTTI or target-access machinery. Larger callables still work and
+/// fall back to the heap. Mainly useful where many small callables are
+/// stored and called in bulk, see e.g. nytl::Callback.
+///
+/// \tparam Signature Uses the same Ret(Args...) syntax as std::function.
+/// \tparam BufSize The inline storage size in bytes.
+template<typename Signature, std::size_t BufSize = 32>
+class Delegate;
+
+template<typename Ret, typename... Args, std::size_t BufSize>
+class Delegate<Ret(Args...), BufSize> {
+public:
+	Delegate() noexcept = default;
+	Delegate(std::nullptr_t) noexcept {}
+
+	template<typename F, typename = std::enable_if_t<
+		!std::is_same_v<std::decay_t<F>, Delegate> &&
+		std::is_invocable_r_v<Ret, std::decay_t<F>&, Args...>>>
+	Delegate(F&& func) {
+		using Impl = std::decay_t<F>;
+		constexpr auto fits = sizeof(Impl) <= sizeof(storage_) &&
+			alignof(Impl) <= alignof(Storage) &&
+			std::is_nothrow_move_constructible_v<Impl>;
+
+		if constexpr(fits) {
+			::new(&storage_) Impl(std::forward<F>(func));
+			invoke_ = [](void* s, Args... args) -> Ret {
+				auto& impl = *std::launder(reinterpret_cast<Impl*>(s));
+				return impl(std::forward<Args>(args)...);
+			};
+			manage_ = [](Op op, void* self, void* other) {
+				auto& impl = *std::launder(reinterpret_cast<Impl*>(self));
+				if(op == Op::destroy) {
+					impl.~Impl();
+				} else {
+					::new(other) Impl(std::move(impl));
+					impl.~Impl();
+				}
+			};
+		} else {
+			// does not fit into the inline storage, store a pointer
+			::new(&storage_) Impl*(new Impl(std::forward<F>(func)));
+			invoke_ = [](void* s, Args... args) -> Ret {
+				auto& impl = **std::launder(reinterpret_cast<Impl**>(s));
+				return impl(std::forward<Args>(args)...);
+			};
+			manage_ = [](Op op, void* self, void* other) {
+				auto ptr = *std::launder(reinterpret_cast<Impl**>(self));
+				if(op == Op::destroy) {
+					delete ptr;
+				} else {
+					::new(other) Impl*(ptr);
+				}
+			};
+		}
+	}
+
+	Delegate(Delegate&& rhs) noexcept {
+		moveFrom(rhs);
+	}
+
+	Delegate& operator=(Delegate&& rhs) noexcept {
+		reset();
+		moveFrom(rhs);
+		return *this;
+	}
+
+	~Delegate() {
+		reset();
+	}
+
+	/// Calls the stored callable.
+	/// Undefined behaviour if the Delegate is empty.
+	Ret operator()(Args... args) {
+		return invoke_(&storage_, std::forward<Args>(args)...);
+	}
+
+	/// Returns whether a callable is stored.
+	explicit operator bool() const noexcept { return invoke_ != nullptr; }
+
+	/// Destroys the stored callable (if any).
+	void reset() noexcept {
+		if(manage_) {
+			manage_(Op::destroy, &storage_, nullptr);
+			invoke_ = nullptr;
+			manage_ = nullptr;
+		}
+	}
+
+protected:
+	enum class Op { destroy, move };
+	using Storage = std::aligned_storage_t<
+		(BufSize > sizeof(void*)) ? BufSize : sizeof(void*)>;
+
+	void moveFrom(Delegate& rhs) noexcept {
+		if(rhs.manage_) {
+			rhs.manage_(Op::move, &rhs.storage_, &storage_);
+			invoke_ = rhs.invoke_;
+			manage_ = rhs.manage_;
+			rhs.invoke_ = nullptr;
+			rhs.manage_ = nullptr;
+		}
+	}
+
+	Storage storage_;
+	Ret (*invoke_)(void*, Args...) {};
+	void (*manage_)(Op, void*, void*) {};
+};
+
+} // namespace nytl
+
+#endif // header guard
@@ -0,0 +1,171 @@
+#pragma once
+
+#include <cmath> // std::sqrt
+#include <cassert>
+#include <cstdint> // std::uint32_t
+
+#include <nytl/quaternion.hpp>
+#include <nytl/vec.hpp>
+#include <nytl/span.hpp>
+
+// Dual quaternion implementation alongside nytl/quaternion.hpp,
+// mainly for representing and blending rigid transforms (rotation +
+// translation) in 8 scalars instead of a full 4x4 matrix.
+// The main use case is skinning: dual-quaternion linear blending (DLB)
+// of bone transforms avoids the shear/scale artifacts of blending
+// matrices component-wise and halves the per-bone data the skinning
+// loop has to stream.
+
+namespace nytl {
+
+// A dual quaternion real + ε * dual.
+// For rigid transforms, 'real' is the (unit) rotation quaternion and
+// 'dual' encodes the translation t as 0.5 * t * real (with t as pure
+// quaternion). Default-constructs to the identity transform.
+class DualQuaternion {
+public:
+	Quaternion real {};
+	Quaternion dual {0.0, 0.0, 0.0, 0.0};
+
+public:
+	// Constructs a dual quaternion from a rotation and a translation,
+	// applying the rotation first.
+	[[nodiscard]] static
+	DualQuaternion fromRotationTranslation(const Quaternion& r, const Vec3d& t) {
+		auto tq = Quaternion {t.x, t.y, t.z, 0.0};
+		return {r, 0.5 * (tq * r)};
+	}
+
+	[[nodiscard]] static
+	DualQuaternion fromTranslation(const Vec3d& t) {
+		return {{}, {0.5 * t.x, 0.5 * t.y, 0.5 * t.z, 0.0}};
+	}
+
+	// Composition, like quaternion/matrix multiplication the right
+	// hand side transform is applied first.
+	DualQuaternion& operator*=(const DualQuaternion& rhs) {
+		auto nreal = real * rhs.real;
+		auto ndual = real * rhs.dual + dual * rhs.real;
+		real = nreal;
+		dual = ndual;
+		return *this;
+	}
+};
+
+// - operators and functions -
+inline DualQuaternion operator*(DualQuaternion a, const DualQuaternion& b) {
+	return (a *= b);
+}
+
+inline DualQuaternion operator*(double f, const DualQuaternion& q) {
+	return {f * q.real, f * q.dual};
+}
+
+inline DualQuaternion operator+(const DualQuaternion& a, const DualQuaternion& b) {
+	return {a.real + b.real, a.dual + b.dual};
+}
+
+inline bool operator==(const DualQuaternion& a, const DualQuaternion& b) {
+	return a.real == b.real && a.dual == b.dual;
+}
+
+inline bool operator!=(const DualQuaternion& a, const DualQuaternion& b) {
+	return a.real != b.real || a.dual != b.dual;
+}
+
+// Returns the conjugate; for unit dual quaternions the inverse transform.
+[[nodiscard]] inline DualQuaternion conjugated(const DualQuaternion& q) {
+	return {conjugated(q.real), conjugated(q.dual)};
+}
+
+// Returns a unit dual quaternion (unit real part, dual part
+// orthogonalized against it), representing the same rigid transform.
+// Needed after blending, see dlb below.
+[[nodiscard]] inline DualQuaternion normalized(const DualQuaternion& q) {
+	auto l = norm(q.real);
+	if(l <= 0.0) {
+		return {};
+	}
+
+	auto real = (1.0 / l) * q.real;
+	auto dual = (1.0 / l) * q.dual;
+
+	// remove the component of dual along real so the translation
+	// stays pure under further operations
+	return {real, dual - dot(real, dual) * real};
+}
+
+// Returns the translation part of the given unit dual quaternion.
+[[nodiscard]] inline Vec3d translation(const DualQuaternion& q) {
+	auto t = 2.0 * (q.dual * conjugated(q.real));
+	return {t.x, t.y, t.z};
+}
+
+// Returns the given point transformed by the rigid transform the
+// given unit dual quaternion represents (rotation, then translation).
+template<typename T>
+[[nodiscard]] Vec3<T> apply(const DualQuaternion& q, const Vec3<T>& v) {
+	return Vec3<T>(Vec3d(apply(q.real, v)) + translation(q));
+}
+
+// Returns a row-major NxN matrix representing the transform of the
+// given unit dual quaternion, e.g. for uploading blended bones to
+// code paths that still consume matrices.
+template<std::size_t N, typename T = float>
+[[nodiscard]] SquareMat<N, T> toMat(const DualQuaternion& q) {
+	static_assert(N >= 4);
+	auto ret = toMat<N, T>(q.real);
+	auto t = translation(q);
+	ret[0][3] = T(t.x);
+	ret[1][3] = T(t.y);
+	ret[2][3] = T(t.z);
+	return ret;
+}
+
+// Dual-quaternion linear blending of the given transforms with the
+// given weights (spans must have the same size, weights are expected
+// to sum to one). Each transform is sign-aligned with the first one
+// so antipodal representations don't cancel out; the weighted sum is
+// normalized at the end, i.e. the result is again rigid.
+[[nodiscard]] inline DualQuaternion dlb(span<const DualQuaternion> transforms,
+		span<const double> weights) {
+	assert(transforms.size() == weights.size());
+	assert(!transforms.empty());
+
+	auto sum = DualQuaternion {{0.0, 0.0, 0.0, 0.0}, {0.0, 0.0, 0.0, 0.0}};
+	for(auto i = 0u; i < transforms.size(); ++i) {
+		auto s = std::copysign(weights[i], dot(transforms[0].real, transforms[i].real));
+		sum = sum + s * transforms[i];
+	}
+
+	return normalized(sum);
+}
+
+// Batch DLB for skinning: for every vertex i, blends the
+// 'influences' bone transforms referenced by the consecutive entries
+// indices[influences * i + j] with weights[influences * i + j] and
+// writes the blended transform to out[i]. The bone palette is walked
+// indirectly, so vertices stream 8 doubles per influence instead of a
+// 4x4 matrix. out.size() determines the vertex count.
+inline void dlb(span<const DualQuaternion> palette,
+		span<const std::uint32_t> indices, span<const double> weights,
+		unsigned influences, span<DualQuaternion> out) {
+	assert(influences > 0);
+	assert(indices.size() >= influences * out.size());
+	assert(weights.size() >= influences * out.size());
+
+	for(auto i = 0u; i < out.size(); ++i) {
+		auto base = i * influences;
+		auto& pivot = palette[indices[base]];
+		auto sum = weights[base] * pivot;
+		for(auto j = 1u; j < influences; ++j) {
+			auto& bone = palette[indices[base + j]];
+			auto s = std::copysign(weights[base + j], dot(pivot.real, bone.real));
+			sum = sum + s * bone;
+		}
+
+		out[i] = normalized(sum);
+	}
+}
+
+} // namespace nytl
@@ -11,6 +11,10 @@
 
 #include <nytl/fwd/flags.hpp> // nytl::Flags default template parameter
 
+#include <cstdint> // std::uintmax_t
+#include <type_traits> // std::make_unsigned
+#include <utility> // std::index_sequence
+
 namespace nytl {
 
 /// \brief Can be used to invert the given value on Flags construction
@@ -67,6 +71,118 @@ template<typename T> constexpr
 Flags<T> operator^(T bit, const Flags<T>& flags) noexcept
 	{ return flags ^ bit; }
 
+// - bit iteration -
+/// Number of set bits in the given flags.
+template<typename T, typename U>
+constexpr unsigned int bitCount(const Flags<T, U>& flags) noexcept {
+	auto value = typename std::make_unsigned<U>::type(flags.value());
+	auto count = 0u;
+	while(value) {
+		value &= value - 1; // clears the lowest set bit
+		++count;
+	}
+
+	return count;
+}
+
+/// The enum value of the lowest set bit, T(0) for empty flags.
+/// `value & -value` isolates the lowest bit, compilers turn this
+/// into a single instruction where available.
+template<typename T, typename U>
+constexpr T lowestBit(const Flags<T, U>& flags) noexcept {
+	auto value = typename std::make_unsigned<U>::type(flags.value());
+	return static_cast<T>(value & (~value + 1));
+}
+
+/// \brief Range over the set bits of a Flags value, lowest bit first.
+/// Yields every set bit as plain enum value, so dispatching over a
+/// render-state mask iterates only the bits that are actually set
+/// instead of testing every possible enum value:
+/// ```cpp
+/// for(auto bit : nytl::bits(changedState)) {
+/// 	apply(bit);
+/// }
+/// ```
+template<typename T, typename U>
+class FlagsRange {
+public:
+	using Unsigned = typename std::make_unsigned<U>::type;
+
+	class Iterator {
+	public:
+		constexpr Iterator(Unsigned rest) noexcept : rest_(rest) {}
+
+		constexpr T operator*() const noexcept {
+			return static_cast<T>(rest_ & (~rest_ + 1));
+		}
+
+		constexpr Iterator& operator++() noexcept {
+			rest_ &= rest_ - 1;
+			return *this;
+		}
+
+		constexpr bool operator==(const Iterator& o) const noexcept
+			{ return rest_ == o.rest_; }
+		constexpr bool operator!=(const Iterator& o) const noexcept
+			{ return rest_ != o.rest_; }
+
+	protected:
+		Unsigned rest_;
+	};
+
+public:
+	constexpr FlagsRange(const Flags<T, U>& flags) noexcept :
+		value_(Unsigned(flags.value())) {}
+
+	constexpr Iterator begin() const noexcept { return {value_}; }
+	constexpr Iterator end() const noexcept { return {0}; }
+
+protected:
+	Unsigned value_;
+};
+
+template<typename T, typename U>
+constexpr FlagsRange<T, U> bits(const Flags<T, U>& flags) noexcept {
+	return {flags};
+}
+
+/// Calls func for every set bit of the given flags, lowest bit first.
+template<typename T, typename U, typename F>
+constexpr void forEachFlag(const Flags<T, U>& flags, F&& func) {
+	for(auto bit : bits(flags)) {
+		func(bit);
+	}
+}
+
+namespace detail {
+
+// if constexpr so func is only ever instantiated for set bits
+template<auto Mask, std::size_t I, typename F>
+constexpr void forEachFlagBit(F& func) {
+	if constexpr((std::uintmax_t(Mask) >> I) & 1u) {
+		func(std::integral_constant<decltype(Mask),
+			static_cast<decltype(Mask)>(std::uintmax_t(1) << I)> {});
+	}
+}
+
+template<auto Mask, typename F, std::size_t... Is>
+constexpr void forEachFlag(F& func, std::index_sequence<Is...>) {
+	(forEachFlagBit<Mask, Is>(func), ...);
+}
+
+} // namespace detail
+
+/// Compile-time variant of forEachFlag: the mask is a template
+/// parameter (an enum value or the underlying value of a constexpr
+/// Flags object), the loop over its set bits unrolls at compile time
+/// and func receives each bit as std::integral_constant, so the bit
+/// stays a constant expression inside the callback.
+template<auto Mask, typename F>
+constexpr void forEachFlag(F&& func) {
+	detail::forEachFlag<Mask>(func,
+		std::make_index_sequence<sizeof(Mask) * 8> {});
+}
+
 } // namespace nytl
 
 /// \brief Can be used for an enum to generate binary operations resulting in nytl::Flags.
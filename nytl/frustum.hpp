@@ -0,0 +1,152 @@
+// Copyright (c) 2017-2020 nyorain
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt
+
+/// \file Frustum plane extraction and batched visibility culling.
+
+#pragma once
+
+#ifndef NYTL_INCLUDE_FRUSTUM
+#define NYTL_INCLUDE_FRUSTUM
+
+#include <nytl/vec.hpp> // nytl::Vec
+#include <nytl/vec3.hpp> // nytl::Vec3
+#include <nytl/mat.hpp> // nytl::Mat
+#include <nytl/rect.hpp> // nytl::Rect
+#include <nytl/span.hpp> // nytl::span
+
+#include <array> // std::array
+#include <cassert> // assert
+#include <cmath> // std::sqrt
+#include <cstdint> // std::uint64_t
+
+namespace nytl {
+
+/// Bounding sphere, the other batch-cullable volume besides Rect<3, P>.
+template<typename P>
+struct Sphere {
+	Vec<3, P> center;
+	P radius;
+};
+
+using Spheref = Sphere<float>;
+
+/// \brief The six planes of a view frustum, extracted from a projection
+/// (or view-projection) matrix via the Gribb/Hartmann method, assuming
+/// the zero-to-one depth convention of the transform.hpp projections.
+/// Planes are stored component-wise (all six x components together and
+/// so on) so the batch cull loops below test one object against all six
+/// planes in a handful of vectorizable operations instead of walking an
+/// array of plane structs. All tests are conservative: an object
+/// reported visible may still be outside (crossing two planes near a
+/// corner), one reported culled never is.
+template<typename P = float>
+class Frustum {
+public:
+	Frustum() = default;
+
+	/// Extracts and normalizes the planes from the given matrix.
+	/// Pass projection * view to cull world-space volumes, just the
+	/// projection for view-space ones.
+	explicit Frustum(const Mat<4, 4, P>& m) {
+		// rows of the matrix; inside halfspace of plane i is
+		// nx x + ny y + nz z + d >= 0
+		const Vec<4, P> rows[4] = {m[0], m[1], m[2], m[3]};
+		const Vec<4, P> planes[6] = {
+			rows[3] + rows[0], // left
+			rows[3] - rows[0], // right
+			rows[3] + rows[1], // bottom
+			rows[3] - rows[1], // top
+			rows[2], // near, z' >= 0
+			rows[3] - rows[2], // far
+		};
+
+		for(auto i = 0u; i < 6; ++i) {
+			auto& p = planes[i];
+			auto len = std::sqrt(p[0] * p[0] + p[1] * p[1] + p[2] * p[2]);
+			nx_[i] = p[0] / len;
+			ny_[i] = p[1] / len;
+			nz_[i] = p[2] / len;
+			d_[i] = p[3] / len;
+		}
+	}
+
+	[[nodiscard]] bool intersects(const Sphere<P>& sphere) const {
+		auto inside = true;
+		for(auto i = 0u; i < 6; ++i) {
+			inside &= nx_[i] * sphere.center.x + ny_[i] * sphere.center.y
+				+ nz_[i] * sphere.center.z + d_[i] >= -sphere.radius;
+		}
+
+		return inside;
+	}
+
+	[[nodiscard]] bool intersects(const Rect<3, P>& box) const {
+		auto c = box.position + P(0.5) * box.size; // center
+		auto e = P(0.5) * box.size; // extents
+		auto inside = true;
+		for(auto i = 0u; i < 6; ++i) {
+			auto radius = absp(nx_[i]) * e.x + absp(ny_[i]) * e.y
+				+ absp(nz_[i]) * e.z;
+			inside &= nx_[i] * c.x + ny_[i] * c.y + nz_[i] * c.z
+				+ d_[i] >= -radius;
+		}
+
+		return inside;
+	}
+
+	/// Batch culling: sets bit i of the visibility mask iff the i-th
+	/// volume (conservatively) intersects the frustum. The mask span
+	/// must hold at least (count + 63) / 64 words; any further words
+	/// are zeroed.
+	void cull(span<const Sphere<P>> spheres, span<std::uint64_t> visible) const {
+		auto words = (spheres.size() + 63) / 64;
+		assert(visible.size() >= words);
+		for(auto w = std::size_t {0}; w < words; ++w) {
+			auto bits = std::uint64_t(0);
+			auto count = std::min(std::size_t(64), spheres.size() - 64 * w);
+			for(auto b = 0u; b < count; ++b) {
+				bits |= std::uint64_t(intersects(spheres[64 * w + b])) << b;
+			}
+
+			visible[w] = bits;
+		}
+
+		for(auto w = words; w < visible.size(); ++w) {
+			visible[w] = 0u;
+		}
+	}
+
+	void cull(span<const Rect<3, P>> boxes, span<std::uint64_t> visible) const {
+		auto words = (boxes.size() + 63) / 64;
+		assert(visible.size() >= words);
+		for(auto w = std::size_t {0}; w < words; ++w) {
+			auto bits = std::uint64_t(0);
+			auto count = std::min(std::size_t(64), boxes.size() - 64 * w);
+			for(auto b = 0u; b < count; ++b) {
+				bits |= std::uint64_t(intersects(boxes[64 * w + b])) << b;
+			}
+
+			visible[w] = bits;
+		}
+
+		for(auto w = words; w < visible.size(); ++w) {
+			visible[w] = 0u;
+		}
+	}
+
+public: // public to keep the SoA planes inspectable, like Vec/Rect
+	std::array<P, 6> nx_ {};
+	std::array<P, 6> ny_ {};
+	std::array<P, 6> nz_ {};
+	std::array<P, 6> d_ {};
+
+private:
+	static P absp(P v) { return v < P(0) ? -v : v; }
+};
+
+using Frustumf = Frustum<float>;
+
+} // namespace nytl
+
+#endif // header guard
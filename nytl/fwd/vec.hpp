@@ -14,10 +14,31 @@ namespace nytl {
 
 using std::size_t;
 
+namespace detail {
+
+// Alignment used for the Vec class definitions.
+// When NYTL_VEC_ALIGN_SIMD is defined (e.g. via the 'simd' meson option),
+// power-of-two sized vectors are aligned to their full size (up to 32
+// bytes) so that compilers can use aligned SSE/NEON loads and stores for
+// the component-wise operator loops. Off by default since it changes the
+// layout/abi of the affected Vec types (Vec<3, T> keeps its padding-free
+// layout either way).
+#ifdef NYTL_VEC_ALIGN_SIMD
+template<size_t D, typename T>
+constexpr size_t vecAlign = ((D & (D - 1)) == 0 && D * sizeof(T) <= 32) ?
+	D * sizeof(T) : alignof(T);
+#else
+template<size_t D, typename T>
+constexpr size_t vecAlign = alignof(T);
+#endif
+
+} // namespace detail
+
 template<size_t D, typename T> class Vec;
 
 template<typename T> class Vec<2, T>; // nytl/vec2.hpp
 template<typename T> class Vec<3, T>; // nytl/vec3.hpp
+template<typename T> class Vec<4, T>; // nytl/vec4.hpp
 
 template<typename T> using Vec2 = Vec<2, T>;
 template<typename T> using Vec3 = Vec<3, T>;
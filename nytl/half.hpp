@@ -0,0 +1,208 @@
+// Copyright (c) 2017-2020 nyorain
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt
+
+/// \file A 16-bit half float type and bulk conversion kernels.
+
+#pragma once
+
+#ifndef NYTL_INCLUDE_HALF
+#define NYTL_INCLUDE_HALF
+
+#include <nytl/vec.hpp> // nytl::Vec
+#include <nytl/span.hpp> // nytl::span
+
+#include <cassert> // assert
+#include <cstdint> // std::uint16_t
+#include <cstring> // std::memcpy
+
+// hardware conversion for the bulk kernels, only with -mf16c
+#ifdef __F16C__
+	#include <immintrin.h>
+#endif
+
+namespace nytl {
+namespace detail {
+
+/// IEEE 754 binary32 -> binary16, round to nearest even.
+/// Handles subnormals, infinities and nans; overflow becomes infinity.
+inline std::uint16_t floatBitsToHalfBits(std::uint32_t bits) {
+	auto sign = std::uint16_t((bits >> 16) & 0x8000u);
+	bits &= 0x7fffffffu;
+
+	if(bits >= 0x7f800000u) { // infinity, nan (quieted, payload kept)
+		auto nan = bits > 0x7f800000u ?
+			0x200u | ((bits & 0x7fffffu) >> 13) : 0u;
+		return sign | 0x7c00u | std::uint16_t(nan);
+	}
+
+	if(bits >= 0x47800000u) { // overflows the half range
+		return sign | 0x7c00u;
+	}
+
+	if(bits >= 0x38800000u) { // normal half range
+		// rebias the exponent; rounding the cut-off mantissa bits may
+		// carry into the exponent and up to infinity, which is exactly
+		// the desired overflow behavior
+		auto half = ((bits >> 13) & 0x3ffu) |
+			((((bits >> 23) & 0xffu) - 112u) << 10);
+		auto rem = bits & 0x1fffu;
+		if(rem > 0x1000u || (rem == 0x1000u && (half & 1u))) {
+			++half;
+		}
+
+		return sign | std::uint16_t(half);
+	}
+
+	// subnormal half or zero
+	auto shift = 126u - (bits >> 23);
+	if(shift > 24u) {
+		return sign;
+	}
+
+	auto mant = (bits & 0x7fffffu) | 0x800000u;
+	auto half = mant >> shift;
+	auto rem = mant & ((1u << shift) - 1);
+	auto halfway = 1u << (shift - 1);
+	if(rem > halfway || (rem == halfway && (half & 1u))) {
+		++half; // may carry into the smallest normal, also correct
+	}
+
+	return sign | std::uint16_t(half);
+}
+
+/// IEEE 754 binary16 -> binary32, always exact.
+inline std::uint32_t halfBitsToFloatBits(std::uint16_t half) {
+	auto sign = std::uint32_t(half & 0x8000u) << 16;
+	auto exp = std::uint32_t(half >> 10) & 0x1fu;
+	auto mant = std::uint32_t(half & 0x3ffu);
+
+	if(exp == 0x1fu) { // infinity, nan
+		return sign | 0x7f800000u | (mant << 13);
+	}
+
+	if(exp == 0u) {
+		if(!mant) { // zero
+			return sign;
+		}
+
+		// normalize the subnormal
+		exp = 113u;
+		while(!(mant & 0x400u)) {
+			mant <<= 1;
+			--exp;
+		}
+
+		mant &= 0x3ffu;
+	} else {
+		exp += 112u;
+	}
+
+	return sign | (exp << 23) | (mant << 13);
+}
+
+} // namespace detail
+
+/// \brief 16-bit IEEE 754 binary16 floating point value.
+/// Storage-only type for halving the bandwidth of GPU uploads and
+/// similar: all arithmetic happens after converting to float, Half only
+/// holds the bits. Conversions round to nearest even.
+class Half {
+public:
+	Half() = default;
+	Half(float value) {
+		std::uint32_t bits;
+		std::memcpy(&bits, &value, sizeof(bits));
+		bits_ = detail::floatBitsToHalfBits(bits);
+	}
+
+	operator float() const {
+		auto bits = detail::halfBitsToFloatBits(bits_);
+		float ret;
+		std::memcpy(&ret, &bits, sizeof(ret));
+		return ret;
+	}
+
+	[[nodiscard]] std::uint16_t bits() const { return bits_; }
+	static Half fromBits(std::uint16_t bits) {
+		Half ret;
+		ret.bits_ = bits;
+		return ret;
+	}
+
+protected:
+	std::uint16_t bits_ {};
+};
+
+static_assert(sizeof(Half) == 2);
+
+using Vec2h = Vec<2, Half>;
+using Vec3h = Vec<3, Half>;
+using Vec4h = Vec<4, Half>;
+
+/// Converts a whole span of floats to halves. Uses the hardware F16C
+/// conversion when the target supports it (-mf16c), otherwise a scalar
+/// bit-twiddling loop. The spans must have the same size.
+inline void convert(span<const float> src, span<Half> dst) {
+	assert(src.size() == dst.size());
+	auto i = std::size_t(0);
+
+#ifdef __F16C__
+	for(; i + 8 <= src.size(); i += 8) {
+		auto floats = _mm256_loadu_ps(&src[i]);
+		auto halves = _mm256_cvtps_ph(floats,
+			_MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(&dst[i]), halves);
+	}
+#endif
+
+	for(; i < src.size(); ++i) {
+		dst[i] = Half(src[i]);
+	}
+}
+
+/// Converts a whole span of halves back to floats.
+inline void convert(span<const Half> src, span<float> dst) {
+	assert(src.size() == dst.size());
+	auto i = std::size_t(0);
+
+#ifdef __F16C__
+	for(; i + 8 <= src.size(); i += 8) {
+		auto halves = _mm_loadu_si128(
+			reinterpret_cast<const __m128i*>(&src[i]));
+		_mm256_storeu_ps(&dst[i], _mm256_cvtph_ps(halves));
+	}
+#endif
+
+	for(; i < src.size(); ++i) {
+		dst[i] = float(src[i]);
+	}
+}
+
+/// Converts a span of float vectors to half vectors component-wise,
+/// e.g. Vec4f colors or Vec2f uvs for a vertex upload.
+template<size_t D>
+void convert(span<const Vec<D, float>> src, span<Vec<D, Half>> dst) {
+	assert(src.size() == dst.size());
+	if(src.empty()) {
+		return;
+	}
+
+	convert(span<const float>(&src[0][0], D * src.size()),
+		span<Half>(&dst[0][0], D * dst.size()));
+}
+
+template<size_t D>
+void convert(span<const Vec<D, Half>> src, span<Vec<D, float>> dst) {
+	assert(src.size() == dst.size());
+	if(src.empty()) {
+		return;
+	}
+
+	convert(span<const Half>(&src[0][0], D * src.size()),
+		span<float>(&dst[0][0], D * dst.size()));
+}
+
+} // namespace nytl
+
+#endif // header guard
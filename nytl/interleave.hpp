@@ -0,0 +1,103 @@
+// Copyright (c) 2017-2020 nyorain
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt
+
+/// \file Fused interleaving of separate attribute arrays into one buffer.
+
+#pragma once
+
+#ifndef NYTL_INCLUDE_INTERLEAVE
+#define NYTL_INCLUDE_INTERLEAVE
+
+#include <nytl/bytes.hpp> // nytl::WriteBuf
+#include <nytl/span.hpp> // nytl::span
+
+#include <cassert> // assert
+#include <cstddef> // std::size_t
+#include <tuple> // std::tuple
+#include <utility> // std::apply
+
+namespace nytl {
+
+/// The per-element stride of a buffer interleaved from the given
+/// attribute types, e.g. interleavedStride<Vec3f, Vec3f, Vec2f>()
+/// for a position/normal/uv vertex layout.
+template<typename... Ts>
+constexpr std::size_t interleavedStride() {
+	return (sizeof(Ts) + ...);
+}
+
+/// Required destination size for interleaving count elements.
+template<typename... Ts>
+constexpr std::size_t interleavedSize(std::size_t count) {
+	return count * interleavedStride<Ts...>();
+}
+
+/// Interleaves the given attribute arrays into the destination buffer
+/// in a single streaming pass: for every index i, the i-th element of
+/// each span is serialized in argument order through the usual bytes()
+/// machinery. All spans must have the same size and dst must hold at
+/// least interleavedSize<Ts...>(size) bytes. Typical use is composing
+/// a GPU vertex buffer from separate position/normal/uv arrays without
+/// one strided pass per attribute:
+/// ```cpp
+/// auto map = nytl::WriteBuf(staging, size);
+/// nytl::interleave(map, positions, normals, uvs);
+/// ```
+/// The single forward pass writes every destination byte exactly once
+/// in order, which is the access pattern write-combined staging memory
+/// wants.
+template<typename... Ts>
+void interleave(WriteBuf& dst, span<const Ts>... attribs) {
+	static_assert(sizeof...(Ts) > 0);
+	const std::size_t sizes[] = {attribs.size()...};
+	for(auto size : sizes) {
+		assert(size == sizes[0]);
+	}
+
+	assert(dst.size() >= interleavedSize<Ts...>(sizes[0]));
+	for(auto i = std::size_t(0); i < sizes[0]; ++i) {
+		(write(dst, ReadBuf(bytes(attribs[i]))), ...);
+	}
+}
+
+template<typename... Ts>
+void interleave(DynWriteBuf& dst, span<const Ts>... attribs) {
+	static_assert(sizeof...(Ts) > 0);
+	const std::size_t sizes[] = {attribs.size()...};
+	for(auto size : sizes) {
+		assert(size == sizes[0]);
+	}
+
+	dst.reserve(dst.size() + interleavedSize<Ts...>(sizes[0]));
+	for(auto i = std::size_t(0); i < sizes[0]; ++i) {
+		(write(dst, ReadBuf(bytes(attribs[i]))), ...);
+	}
+}
+
+/// Overloads taking the format as one tuple of attribute spans, for
+/// callers that build the description programmatically.
+template<typename B, typename... Ts>
+void interleave(B& dst, const std::tuple<span<const Ts>...>& attribs) {
+	std::apply([&](auto... spans) { interleave(dst, spans...); }, attribs);
+}
+
+/// Splits an interleaved buffer back into separate attribute arrays,
+/// the exact inverse of interleave() for the same span types.
+template<typename... Ts>
+void deinterleave(ReadBuf& src, span<Ts>... attribs) {
+	static_assert(sizeof...(Ts) > 0);
+	const std::size_t sizes[] = {attribs.size()...};
+	for(auto size : sizes) {
+		assert(size == sizes[0]);
+	}
+
+	assert(src.size() >= interleavedSize<Ts...>(sizes[0]));
+	for(auto i = std::size_t(0); i < sizes[0]; ++i) {
+		(read(src, bytes(attribs[i])), ...);
+	}
+}
+
+} // namespace nytl
+
+#endif // header guard
@@ -0,0 +1,152 @@
+// Copyright (c) 2017-2020 nyorain
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt
+
+/// \file Heavy loop kernels, optionally compiled with runtime CPU dispatch.
+/// By default nytl stays header-only and these are plain inline scalar
+/// loops. With the 'kernels' meson option the same functions come from
+/// the nytl-kernels static library instead, compiled once per instruction
+/// set (via function multi-versioning) with the best clone picked at load
+/// time, so a lowest-common-ISA binary still runs AVX2 loops on machines
+/// that have it. Headers like vecBatchOps.hpp route their hot float loops
+/// through here, callers never need to care which variant they get.
+
+#pragma once
+
+#ifndef NYTL_INCLUDE_KERNELS
+#define NYTL_INCLUDE_KERNELS
+
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uint32_t
+
+#ifdef NYTL_KERNELS
+	#define NYTL_KERNELS_FN
+#else
+	#define NYTL_KERNELS_FN inline
+	#include <cmath> // std::sqrt
+#endif
+
+namespace nytl {
+namespace kernels {
+
+/// out[i] = a[i] * b[i]
+NYTL_KERNELS_FN void mulSpan(const float* a, const float* b, float* out,
+	std::size_t count)
+#ifdef NYTL_KERNELS
+	;
+#else
+{
+	for(auto i = std::size_t(0); i < count; ++i) {
+		out[i] = a[i] * b[i];
+	}
+}
+#endif
+
+/// out[i] += a[i] * b[i]
+NYTL_KERNELS_FN void fmaddSpan(const float* a, const float* b, float* out,
+	std::size_t count)
+#ifdef NYTL_KERNELS
+	;
+#else
+{
+	for(auto i = std::size_t(0); i < count; ++i) {
+		out[i] += a[i] * b[i];
+	}
+}
+#endif
+
+/// values[i] = sqrt(values[i])
+NYTL_KERNELS_FN void sqrtSpan(float* values, std::size_t count)
+#ifdef NYTL_KERNELS
+	;
+#else
+{
+	for(auto i = std::size_t(0); i < count; ++i) {
+		values[i] = std::sqrt(values[i]);
+	}
+}
+#endif
+
+/// dst[i] = mat * src[i] for count packed xyzw vectors,
+/// mat is a row-major 4x4 matrix.
+NYTL_KERNELS_FN void transform4(const float* mat, const float* src,
+	float* dst, std::size_t count)
+#ifdef NYTL_KERNELS
+	;
+#else
+{
+	for(auto i = std::size_t(0); i < count; ++i) {
+		auto* v = src + 4 * i;
+		auto* o = dst + 4 * i;
+		for(auto r = 0u; r < 4; ++r) {
+			o[r] = mat[4 * r + 0] * v[0] + mat[4 * r + 1] * v[1]
+				+ mat[4 * r + 2] * v[2] + mat[4 * r + 3] * v[3];
+		}
+	}
+}
+#endif
+
+/// In-place byte reversal of count 2/4/8-byte values.
+NYTL_KERNELS_FN void byteswap2(std::uint16_t* values, std::size_t count)
+#ifdef NYTL_KERNELS
+	;
+#else
+{
+	for(auto i = std::size_t(0); i < count; ++i) {
+		values[i] = std::uint16_t(values[i] << 8 | values[i] >> 8);
+	}
+}
+#endif
+
+NYTL_KERNELS_FN void byteswap4(std::uint32_t* values, std::size_t count)
+#ifdef NYTL_KERNELS
+	;
+#else
+{
+	for(auto i = std::size_t(0); i < count; ++i) {
+		auto v = values[i];
+		values[i] = (v << 24) | ((v & 0xff00u) << 8)
+			| ((v >> 8) & 0xff00u) | (v >> 24);
+	}
+}
+#endif
+
+NYTL_KERNELS_FN void byteswap8(std::uint64_t* values, std::size_t count)
+#ifdef NYTL_KERNELS
+	;
+#else
+{
+	for(auto i = std::size_t(0); i < count; ++i) {
+		auto v = values[i];
+		v = (v >> 32) | (v << 32);
+		v = ((v & 0xffff0000ffff0000u) >> 16)
+			| ((v & 0x0000ffff0000ffffu) << 16);
+		v = ((v & 0xff00ff00ff00ff00u) >> 8)
+			| ((v & 0x00ff00ff00ff00ffu) << 8);
+		values[i] = v;
+	}
+}
+#endif
+
+/// Number of utf-8 code points in the given bytes (continuation
+/// bytes don't count).
+NYTL_KERNELS_FN std::size_t charCount8(const char* data, std::size_t size)
+#ifdef NYTL_KERNELS
+	;
+#else
+{
+	auto count = std::size_t(0);
+	for(auto i = std::size_t(0); i < size; ++i) {
+		count += (std::uint8_t(data[i]) & 0xc0u) != 0x80u;
+	}
+
+	return count;
+}
+#endif
+
+} // namespace kernels
+} // namespace nytl
+
+#undef NYTL_KERNELS_FN
+
+#endif // header guard
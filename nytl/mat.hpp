@@ -73,13 +73,29 @@ constexpr Mat<R, C, T>::operator Mat<OR, OC, OT>() const {
 }
 
 // mat * mat
+// Computes every result row as a linear combination of the rows of b.
+// In difference to the naive triple loop this never walks b column-wise,
+// i.e. both matrices are accessed sequentially in memory and the inner
+// loop is a pure multiply-add over a row that compilers unroll and
+// vectorize well (fully unrolled for the common 2/3/4 transform sizes).
+// For larger compile-time dimensions the inner dimension is additionally
+// blocked so the touched rows of b stay in cache.
 template<typename T1, typename T2, size_t R, size_t M, size_t C>
 constexpr auto operator*(const Mat<R, M, T1>& a, const Mat<M, C, T2>& b) {
 	Mat<R, C, decltype(a[0][0] * b[0][0] + a[0][0] * b[0][0])> ret {};
-	for(auto r = 0u; r < R; ++r) // ret: rows
-		for(auto c = 0u; c < C; ++c) // ret: cols
-			for(auto i = 0u; i < M; ++i) // row + col dot
-				ret[r][c] += a[r][i] * b[i][c];
+	if constexpr(M <= 8) {
+		for(auto r = 0u; r < R; ++r) // ret: rows
+			for(auto i = 0u; i < M; ++i) // row of b
+				for(auto c = 0u; c < C; ++c) // ret: cols
+					ret[r][c] += a[r][i] * b[i][c];
+	} else {
+		constexpr auto block = size_t {8};
+		for(auto bi = size_t {0}; bi < M; bi += block)
+			for(auto r = 0u; r < R; ++r)
+				for(auto i = bi; i < std::min(M, bi + block); ++i)
+					for(auto c = 0u; c < C; ++c)
+						ret[r][c] += a[r][i] * b[i][c];
+	}
 	return ret;
 }
 
@@ -93,13 +109,14 @@ constexpr auto operator*(const Mat<R, C, T1>& a, const Vec<C, T2>& b) {
 }
 
 // mat *= mat (quadratic)
+// Uses the same row-major friendly loop order as operator*.
 template<typename T1, typename T2, size_t D>
 constexpr auto& operator*=(Mat<D, D, T1>& a, const Mat<D, D, T2>& b) {
 	auto tmp = a; // needed since we write to a
 	a = {};
 	for(auto r = 0u; r < D; ++r) // ret: rows
-		for(auto c = 0u; c < D; ++c) // ret: cols
-			for(auto i = 0u; i < D; ++i) // row + col dot
+		for(auto i = 0u; i < D; ++i) // row of b
+			for(auto c = 0u; c < D; ++c) // ret: cols
 				a[r][c] += tmp[r][i] * b[i][c];
 	return a;
 }
@@ -12,12 +12,14 @@
 #include <nytl/tmpUtil.hpp> // nytl::templatize
 #include <nytl/mat.hpp> // nytl::Mat
 #include <nytl/vecOps.hpp> // nytl::dot
+#include <nytl/span.hpp> // nytl::span
 
 #include <utility> // std::swap
 #include <stdexcept> // std::invalid_argument
 #include <tuple> // std::tuple
 #include <iosfwd> // std::ostream
 #include <cmath> // std::fma
+#include <cassert> // assert
 
 namespace nytl {
 
@@ -33,6 +35,15 @@ struct LUDecomposition {
 	unsigned int sign = 1;
 };
 
+/// The return type of a cholesky decomposition, see choleskyDecomp.
+/// Represents the factorization A = L * transpose(L) of a symmetric
+/// positive-definite matrix A. Like LUDecomposition it can be reused
+/// by determinant, inverse and choleskySolve without decomposing again.
+template<size_t D, typename T>
+struct CholeskyDecomposition {
+	nytl::Mat<D, D, T> lower;
+};
+
 /// \brief Prints the given matrix with numerical values to the given ostream.
 /// If this function is used, header <ostream> must be included.
 /// This function does not implement operator<< since this operator should only implemented
@@ -83,6 +94,37 @@ std::ostream& operator<<(std::ostream& os, const Mat<R, C, T>& a) {
 	return print(os, a);
 }
 
+/// Formats the given matrix into the given character buffer via
+/// std::to_chars, without allocations or locale machinery.
+/// Writes the rows as "{(a, b), (c, d)}", i.e. more compact than print
+/// (no padding, no newlines), suitable for single-line logging.
+/// Returns the number of characters written, 0 if the buffer was too small.
+template<size_t R, size_t C, typename T>
+size_t format(span<char> buf, const Mat<R, C, T>& mat) {
+	auto rest = buf;
+	auto ok = true;
+	detail::formatAppend(rest, std::string_view("{"), ok);
+	for(auto r = 0u; r < R; ++r) {
+		if(r != 0) {
+			detail::formatAppend(rest, std::string_view(", "), ok);
+		}
+
+		detail::formatAppend(rest, std::string_view("("), ok);
+		for(auto c = 0u; c < C; ++c) {
+			if(c != 0) {
+				detail::formatAppend(rest, std::string_view(", "), ok);
+			}
+
+			detail::formatAppend(rest, mat[r][c], ok);
+		}
+
+		detail::formatAppend(rest, std::string_view(")"), ok);
+	}
+
+	detail::formatAppend(rest, std::string_view("}"), ok);
+	return ok ? buf.size() - rest.size() : 0;
+}
+
 /// \brief Returns the column with index n of the given matrix.
 /// For example: `nytl::mat::row(mat44, 1);` returns the second (index 1) column of a matrix.
 template<size_t R, size_t C, typename T>
@@ -413,6 +455,112 @@ constexpr auto luEvaluate(const LUDecomposition<D, T1>& lu, const Vec<D, T2>& b)
 	return luEvaluate(lu.lower, lu.upper, transpose(lu.perm) * b);
 }
 
+/// \brief Batch overload of luEvaluate, solves LUx = b for many right-hand sides.
+/// Writes the solution for b[n] into x[n], both spans must have the same size.
+/// The substitutions run row-by-row across the whole batch, so every
+/// factor row is loaded once per batch instead of once per vector.
+/// See the single-vector luEvaluate overload for the exact semantics,
+/// especially regarding permutation and singular factors.
+template<size_t D, typename T1, typename T2>
+constexpr void luEvaluate(const Mat<D, D, T1>& l, const Mat<D, D, T1>& u,
+		span<const Vec<D, T2>> b, span<Vec<D, double>> x) {
+	assert(b.size() == x.size());
+
+	// forward substitution, the intermediate vector d lives in x
+	for(auto i = 0u; i < D; ++i) {
+		for(auto n = 0u; n < b.size(); ++n) {
+			x[n][i] = b[n][i];
+			for(auto j = 0u; j < i; ++j)
+				x[n][i] -= l[i][j] * x[n][j];
+
+			x[n][i] /= l[i][i];
+		}
+	}
+
+	// back substitution, in place
+	for(auto i = D; i-- > 0; ) {
+		for(auto n = 0u; n < b.size(); ++n) {
+			for(auto j = i + 1; j < D; ++j)
+				x[n][i] -= u[i][j] * x[n][j];
+
+			x[n][i] /= u[i][i];
+		}
+	}
+}
+
+/// \brief Batch overload of luEvaluate for a whole decomposition.
+/// The inverse permutation is computed once and applied to every
+/// right-hand side, solving Ax = b for each vector in the batch.
+template<size_t D, typename T1, typename T2>
+constexpr void luEvaluate(const LUDecomposition<D, T1>& lu,
+		span<const Vec<D, T2>> b, span<Vec<D, double>> x) {
+	assert(b.size() == x.size());
+
+	auto pt = transpose(lu.perm);
+	for(auto n = 0u; n < b.size(); ++n) {
+		x[n] = static_cast<Vec<D, double>>(pt * b[n]);
+	}
+
+	// forward substitution on the permuted vectors, in place
+	for(auto i = 0u; i < D; ++i) {
+		for(auto n = 0u; n < b.size(); ++n) {
+			for(auto j = 0u; j < i; ++j)
+				x[n][i] -= lu.lower[i][j] * x[n][j];
+
+			x[n][i] /= lu.lower[i][i];
+		}
+	}
+
+	// back substitution, in place
+	for(auto i = D; i-- > 0; ) {
+		for(auto n = 0u; n < b.size(); ++n) {
+			for(auto j = i + 1; j < D; ++j)
+				x[n][i] -= lu.upper[i][j] * x[n][j];
+
+			x[n][i] /= lu.upper[i][i];
+		}
+	}
+}
+
+/// \brief Matrix-valued overload of luEvaluate, returns X so that LUX = B.
+/// The right-hand sides are the columns of B, i.e. column n of the
+/// returned matrix solves the system for col(B, n).
+template<size_t D, size_t N, typename T1, typename T2>
+constexpr auto luEvaluate(const Mat<D, D, T1>& l, const Mat<D, D, T1>& u,
+		const Mat<D, N, T2>& b) {
+	auto x = static_cast<Mat<D, N, double>>(b);
+
+	// forward substitution across all columns
+	for(auto i = 0u; i < D; ++i) {
+		for(auto j = 0u; j < i; ++j) {
+			for(auto n = 0u; n < N; ++n)
+				x[i][n] -= l[i][j] * x[j][n];
+		}
+
+		x[i] = (1.0 / l[i][i]) * x[i];
+	}
+
+	// back substitution
+	for(auto i = D; i-- > 0; ) {
+		for(auto j = i + 1; j < D; ++j) {
+			for(auto n = 0u; n < N; ++n)
+				x[i][n] -= u[i][j] * x[j][n];
+		}
+
+		x[i] = (1.0 / u[i][i]) * x[i];
+	}
+
+	return x;
+}
+
+/// \brief Matrix-valued overload of luEvaluate for a whole decomposition.
+/// Returns X so that AX = B for the decomposed matrix A.
+template<size_t D, size_t N, typename T1, typename T2>
+constexpr auto luEvaluate(const LUDecomposition<D, T1>& lu, const Mat<D, N, T2>& b) {
+	return luEvaluate(lu.lower, lu.upper,
+		static_cast<Mat<D, N, double>>(transpose(lu.perm) * b));
+}
+
 /// \brief Returns the determinant of the given square matrix.
 /// Complexity Lies within O(n^3) where n is the number of rows/cols of the given matrix.
 /// If you already have a lu-decomposition, see the next overload of this function.
@@ -462,6 +610,72 @@ constexpr auto inverse(const LUDecomposition<D, T>& lu) {
 	return ret;
 }
 
+/// \brief Returns the inverse of the given affine transform matrix.
+/// The matrix must be an affine homogeneous transform, i.e. its last row
+/// must be (0, ..., 0, 1), like the matrices produced by nytl/transform.hpp
+/// (asserted in debug builds). Instead of decomposing the full matrix,
+/// only the upper-left block is inverted and the translation column is
+/// backtransformed, which is considerably cheaper than the general
+/// luDecomp-based inverse. For orthonormal upper-left blocks (no scale),
+/// see rigidInverse.
+/// Undefined behaviour if the upper-left block is not invertible.
+template<size_t D, typename T>
+constexpr auto affineInverse(const Mat<D, D, T>& mat) {
+	static_assert(D >= 2, "nytl::affineInverse: requires a homogeneous matrix");
+	for(auto c = 0u; c < D - 1; ++c) {
+		assert(mat[D - 1][c] == T {0});
+	}
+	assert(mat[D - 1][D - 1] == T {1});
+
+	// invert the upper-left block
+	Mat<D - 1, D - 1, T> a {};
+	for(auto r = 0u; r < D - 1; ++r) {
+		for(auto c = 0u; c < D - 1; ++c) {
+			a[r][c] = mat[r][c];
+		}
+	}
+
+	auto inv = inverse(a);
+
+	// ret = [inv, -inv * t; 0, 1]
+	Mat<D, D, double> ret {};
+	for(auto r = 0u; r < D - 1; ++r) {
+		for(auto c = 0u; c < D - 1; ++c) {
+			ret[r][c] = inv[r][c];
+			ret[r][D - 1] -= inv[r][c] * mat[c][D - 1];
+		}
+	}
+
+	ret[D - 1][D - 1] = 1.0;
+	return ret;
+}
+
+/// \brief Returns the inverse of the given rigid transform matrix.
+/// Like affineInverse, but additionally requires the upper-left block of
+/// the matrix to be orthonormal (rotation and translation only, no
+/// scale; not asserted), so its inverse is just the transpose and no
+/// divisions are needed at all.
+template<size_t D, typename T>
+constexpr auto rigidInverse(const Mat<D, D, T>& mat) {
+	static_assert(D >= 2, "nytl::rigidInverse: requires a homogeneous matrix");
+	for(auto c = 0u; c < D - 1; ++c) {
+		assert(mat[D - 1][c] == T {0});
+	}
+	assert(mat[D - 1][D - 1] == T {1});
+
+	// ret = [transposed, -transposed * t; 0, 1]
+	Mat<D, D, T> ret {};
+	for(auto r = 0u; r < D - 1; ++r) {
+		for(auto c = 0u; c < D - 1; ++c) {
+			ret[r][c] = mat[c][r];
+			ret[r][D - 1] -= mat[c][r] * mat[c][D - 1];
+		}
+	}
+
+	ret[D - 1][D - 1] = T {1};
+	return ret;
+}
+
 /// \brief Returns whether the given quadratic matrix is symmetric.
 template<size_t D, typename T>
 constexpr bool symmetric(const nytl::Mat<D, D, T>& mat) {
@@ -476,6 +690,95 @@ constexpr bool symmetric(const nytl::Mat<D, D, T>& mat) {
 	return true;
 }
 
+/// \brief Computes the cholesky decomposition of the given matrix.
+/// The matrix must be symmetric (see the symmetric predicate) and
+/// positive definite, otherwise the result is undefined. For such
+/// matrices this does roughly half the work of luDecomp and needs
+/// neither pivot search nor a permutation matrix.
+/// The returned lower matrix fulfills A = L * transpose(L).
+/// Complexity Lies within O(n^3) where n is the number of rows/cols
+/// of the given matrix.
+template<size_t D, typename T>
+constexpr CholeskyDecomposition<D, double> choleskyDecomp(const nytl::Mat<D, D, T>& mat) {
+	CholeskyDecomposition<D, double> ret {};
+	auto& l = ret.lower;
+
+	for(auto i = 0u; i < D; ++i) {
+		for(auto j = 0u; j <= i; ++j) {
+			auto sum = static_cast<double>(mat[i][j]);
+			for(auto k = 0u; k < j; ++k) {
+				sum -= l[i][k] * l[j][k];
+			}
+
+			if(i == j) {
+				l[i][j] = std::sqrt(sum);
+			} else {
+				l[i][j] = sum / l[j][j];
+			}
+		}
+	}
+
+	return ret;
+}
+
+/// \brief Returns the vector x so that Ax = b for the decomposed matrix A.
+/// Performs forward substitution with L and backward substitution with
+/// its transpose, no permutation handling is needed.
+/// Undefined behaviour if the decomposition is singular.
+/// Complexity Lies within O(n^2) where n is the number of rows/cols of the matrix.
+template<size_t D, typename T1, typename T2>
+constexpr auto choleskySolve(const CholeskyDecomposition<D, T1>& chol,
+		const Vec<D, T2>& b) {
+	auto& l = chol.lower;
+
+	// forward substitution: L d = b
+	Vec<D, double> d {};
+	for(auto i = 0u; i < D; ++i) {
+		d[i] = b[i];
+		for(auto j = 0u; j < i; ++j)
+			d[i] -= l[i][j] * d[j];
+
+		d[i] /= l[i][i];
+	}
+
+	// back substitution: transpose(L) x = d
+	Vec<D, double> x {};
+	for(auto i = D; i-- > 0; ) {
+		x[i] = d[i];
+		for(auto j = i + 1; j < D; ++j)
+			x[i] -= l[j][i] * x[j];
+
+		x[i] /= l[i][i];
+	}
+
+	return x;
+}
+
+/// \brief Returns the determinant for the cholesky decomposition of a matrix.
+/// The determinant of a symmetric positive-definite matrix is the
+/// squared product of the diagonal of its cholesky factor.
+template<size_t D, typename T>
+constexpr auto determinant(const CholeskyDecomposition<D, T>& chol) {
+	auto diag = multiplyDiagonal(chol.lower);
+	return diag * diag;
+}
+
+/// \brief Returns the inverse of the matrix that is represented by the
+/// given cholesky decomposition.
+/// Undefined behaviour if the decomposition is singular.
+template<size_t D, typename T>
+constexpr auto inverse(const CholeskyDecomposition<D, T>& chol) {
+	Mat<D, D, T> ret {};
+	Vec<D, T> e {};
+	for(auto i = 0u; i < D; ++i) {
+		e[i] = T {1};
+		col(ret, i, choleskySolve(chol, e));
+		e[i] = T {0};
+	}
+
+	return ret;
+}
+
 } // namespace nytl
 
 #endif // header guard
@@ -10,6 +10,7 @@
 #define NYTL_INCLUDE_SCALAR
 
 #include <algorithm> // std::clamp
+#include <cstdint> // std::uint64_t
 
 namespace nytl {
 namespace constants {
@@ -68,6 +69,17 @@ constexpr int unmapUnsigned(unsigned int x) {
 	return (ix % 2) ? -(ix + 1) / 2 : ix / 2;
 }
 
+/// 64-bit overload of mapUnsigned (zigzag encoding), branchless,
+/// e.g. for varint encoding of signed timestamps or deltas.
+constexpr std::uint64_t mapUnsigned(std::int64_t x) {
+	return (std::uint64_t(x) << 1) ^ std::uint64_t(x >> 63);
+}
+
+/// Reverses the 64-bit mapUnsigned overload.
+constexpr std::int64_t unmapUnsigned(std::uint64_t x) {
+	return std::int64_t(x >> 1) ^ -std::int64_t(x & 1);
+}
+
 /// Combines the two given unsigned numbers into a single unique one
 /// using the cantorsche pairing function. Combine it with calls
 /// to mapUnsigned to enable it for signed x,y inputs.
@@ -91,6 +103,128 @@ constexpr auto clampStore(float value, float min, float max, int& store) {
 	return value;
 }
 
+// - fast constexpr trigonometry -
+namespace detail {
+
+/// Rounds to the nearest integer, valid for |x| < 2^62.
+constexpr double roundNearest(double x) {
+	return double(std::int64_t(x >= 0.0 ? x + 0.5 : x - 0.5));
+}
+
+constexpr double absd(double x) {
+	return x < 0.0 ? -x : x;
+}
+
+/// Polynomial for sin on [-pi/2, pi/2], truncation error < 1e-9.
+constexpr double sinPoly(double x) {
+	auto x2 = x * x;
+	return x * (1.0 + x2 * (-1.0 / 6
+		+ x2 * (1.0 / 120
+		+ x2 * (-1.0 / 5040
+		+ x2 * (1.0 / 362880
+		+ x2 * (-1.0 / 39916800
+		+ x2 * (1.0 / 6227020800)))))));
+}
+
+/// Polynomial for cos on [-pi/2, pi/2], truncation error < 1e-9.
+constexpr double cosPoly(double x) {
+	auto x2 = x * x;
+	return 1.0 + x2 * (-1.0 / 2
+		+ x2 * (1.0 / 24
+		+ x2 * (-1.0 / 720
+		+ x2 * (1.0 / 40320
+		+ x2 * (-1.0 / 3628800
+		+ x2 * (1.0 / 479001600
+		+ x2 * (-1.0 / 87178291200)))))));
+}
+
+/// atan on [0, 1]: values above tan(pi/8) are folded down to
+/// [-tan(pi/8), tan(pi/8)] where the series converges quickly,
+/// truncation error < 1e-9.
+constexpr double atanPoly(double x) {
+	auto offset = 0.0;
+	if(x > 0.41421356237309503) { // tan(pi/8)
+		offset = constants::pi / 4;
+		x = (x - 1.0) / (x + 1.0);
+	}
+
+	auto x2 = x * x;
+	return offset + x * (1.0 + x2 * (-1.0 / 3
+		+ x2 * (1.0 / 5
+		+ x2 * (-1.0 / 7
+		+ x2 * (1.0 / 9
+		+ x2 * (-1.0 / 11
+		+ x2 * (1.0 / 13
+		+ x2 * (-1.0 / 15
+		+ x2 * (1.0 / 17
+		+ x2 * (-1.0 / 19))))))))));
+}
+
+} // namespace detail
+
+/// Result of the combined sin/cos evaluation below.
+struct SinCos {
+	double sin;
+	double cos;
+};
+
+/// \brief Computes sin and cos of the given angle (radians) at once.
+/// Polynomial approximation that, unlike the libm functions, is
+/// constexpr and inlinable; both values share one range reduction.
+/// Absolute error is below 2e-9 for angles up to a few hundred radians
+/// (the naive reduction loses precision for huge angles).
+constexpr SinCos fastSinCos(double angle) {
+	constexpr auto pi = constants::pi;
+
+	// reduce to [-pi, pi], then to [-pi/2, pi/2] via symmetry
+	auto r = angle - 2.0 * pi * detail::roundNearest(angle / (2.0 * pi));
+	auto negate = false;
+	if(r > pi / 2) {
+		r = pi - r;
+		negate = true;
+	} else if(r < -pi / 2) {
+		r = -pi - r;
+		negate = true;
+	}
+
+	auto cos = detail::cosPoly(r);
+	return {detail::sinPoly(r), negate ? -cos : cos};
+}
+
+/// See fastSinCos for accuracy and range notes.
+constexpr double fastSin(double angle) {
+	return fastSinCos(angle).sin;
+}
+
+constexpr double fastCos(double angle) {
+	return fastSinCos(angle).cos;
+}
+
+/// \brief Constexpr polynomial approximation of atan2(y, x).
+/// Returns the angle of (x, y) in (-pi, pi], zero for the origin.
+/// Absolute error is below 3e-9.
+constexpr double fastAtan2(double y, double x) {
+	constexpr auto pi = constants::pi;
+	auto ax = detail::absd(x);
+	auto ay = detail::absd(y);
+	if(ax == 0.0 && ay == 0.0) {
+		return 0.0;
+	}
+
+	// evaluate the polynomial on [0, 1], undo the folding afterwards
+	auto swap = ay > ax;
+	auto r = detail::atanPoly(swap ? ax / ay : ay / ax);
+	if(swap) {
+		r = pi / 2 - r;
+	}
+
+	if(x < 0.0) {
+		r = pi - r;
+	}
+
+	return y < 0.0 ? -r : r;
+}
+
 } // namespace nytl
 
 #endif // header guard
@@ -0,0 +1,130 @@
+// Copyright (c) 2017-2020 nyorain
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt
+
+/// \file Defines MmapReadBuf, a memory-mapped file source for the
+/// byte reading utilities in nytl/bytes.hpp. POSIX only.
+
+#pragma once
+
+#ifndef NYTL_INCLUDE_MMAP_BUF
+#define NYTL_INCLUDE_MMAP_BUF
+
+#include <nytl/bytes.hpp> // nytl::ReadBuf
+
+#include <utility> // std::exchange
+#include <system_error> // std::system_error
+
+#include <sys/mman.h> // mmap
+#include <sys/stat.h> // fstat
+#include <fcntl.h> // open
+#include <unistd.h> // close
+
+namespace nytl {
+
+/// RAII wrapper around a read-only memory mapping of a file.
+/// Exposes the mapping as ReadBuf so the read/skip/copy utilities from
+/// nytl/bytes.hpp can deserialize directly from the file, without
+/// first copying its contents into an owned buffer.
+/// The spans handed out reference the mapping and must not outlive it.
+class MmapReadBuf {
+public:
+	/// Expected access pattern of the mapping, forwarded to the kernel
+	/// (madvise) so it can adjust readahead accordingly.
+	enum class Access {
+		normal,
+		sequential,
+		random
+	};
+
+public:
+	MmapReadBuf() = default;
+
+	/// Maps the file at the given path.
+	/// \throws std::system_error If the file can't be opened or mapped.
+	explicit MmapReadBuf(const char* path, Access access = Access::sequential) {
+		auto fd = ::open(path, O_RDONLY);
+		if(fd < 0) {
+			throw std::system_error(errno, std::generic_category(),
+				"nytl::MmapReadBuf: open");
+		}
+
+		struct stat st {};
+		if(::fstat(fd, &st) != 0) {
+			auto err = errno;
+			::close(fd);
+			throw std::system_error(err, std::generic_category(),
+				"nytl::MmapReadBuf: fstat");
+		}
+
+		size_ = static_cast<std::size_t>(st.st_size);
+		if(size_ > 0) {
+			auto ptr = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+			if(ptr == MAP_FAILED) {
+				auto err = errno;
+				::close(fd);
+				throw std::system_error(err, std::generic_category(),
+					"nytl::MmapReadBuf: mmap");
+			}
+
+			data_ = static_cast<const std::byte*>(ptr);
+			advise(access);
+		}
+
+		// the mapping keeps its own reference to the file
+		::close(fd);
+	}
+
+	~MmapReadBuf() {
+		if(data_) {
+			::munmap(const_cast<std::byte*>(data_), size_);
+		}
+	}
+
+	MmapReadBuf(MmapReadBuf&& rhs) noexcept :
+		data_(std::exchange(rhs.data_, nullptr)),
+		size_(std::exchange(rhs.size_, 0)) {
+	}
+
+	MmapReadBuf& operator=(MmapReadBuf&& rhs) noexcept {
+		if(data_) {
+			::munmap(const_cast<std::byte*>(data_), size_);
+		}
+
+		data_ = std::exchange(rhs.data_, nullptr);
+		size_ = std::exchange(rhs.size_, 0);
+		return *this;
+	}
+
+	/// Changes the advised access pattern of the mapping.
+	void advise(Access access) {
+		if(!data_) {
+			return;
+		}
+
+		auto adv = MADV_NORMAL;
+		switch(access) {
+			case Access::sequential: adv = MADV_SEQUENTIAL; break;
+			case Access::random: adv = MADV_RANDOM; break;
+			default: break;
+		}
+
+		::madvise(const_cast<std::byte*>(data_), size_, adv);
+	}
+
+	/// Returns the whole mapped file as ReadBuf.
+	ReadBuf buf() const { return {data_, size_}; }
+	operator ReadBuf() const { return buf(); }
+
+	const std::byte* data() const { return data_; }
+	std::size_t size() const { return size_; }
+	bool mapped() const { return data_ != nullptr; }
+
+protected:
+	const std::byte* data_ {};
+	std::size_t size_ {};
+};
+
+} // namespace nytl
+
+#endif // NYTL_INCLUDE_MMAP_BUF
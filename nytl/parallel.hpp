@@ -0,0 +1,250 @@
+// Copyright (c) 2017-2020 nyorain
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt
+
+/// \file Parallel algorithms over span, backed by a lazily created pool.
+
+#pragma once
+
+#ifndef NYTL_INCLUDE_PARALLEL
+#define NYTL_INCLUDE_PARALLEL
+
+#include <nytl/span.hpp> // nytl::span
+
+#include <algorithm> // std::min
+#include <atomic> // std::atomic
+#include <condition_variable> // std::condition_variable
+#include <cstddef> // std::size_t
+#include <mutex> // std::mutex
+#include <thread> // std::thread
+#include <type_traits> // std::remove_reference_t
+#include <utility> // std::move
+#include <vector> // std::vector
+
+namespace nytl {
+namespace detail {
+
+/// Shared thread pool behind the parallel* algorithms.
+/// Threads are spawned on first use and otherwise sleep; a running job
+/// publishes its chunk range and workers (plus the submitting thread)
+/// claim chunks from a shared atomic index, which load-balances uneven
+/// chunks the same way stealing from per-thread deques would without
+/// needing the deques for span-shaped work.
+class ParallelPool {
+public:
+	/// Type-erased description of one running job, lives on the
+	/// stack of the submitting thread for the duration of the call.
+	struct Job {
+		void (*run)(Job&, std::size_t begin, std::size_t end) {};
+		void* impl {};
+		std::size_t end {};
+		std::size_t grain {};
+		std::atomic<std::size_t> next {};
+		unsigned active {}; // workers inside run, protected by mutex_
+	};
+
+public:
+	static ParallelPool& instance() {
+		static ParallelPool pool;
+		return pool;
+	}
+
+	/// Set while the current thread executes chunks (always for pool
+	/// workers). parallel* calls on such a thread run serially instead
+	/// of blocking on the pool, making nested parallelism safe.
+	static bool& insideJob() {
+		static thread_local bool inside = false;
+		return inside;
+	}
+
+	unsigned workerCount() const { return threads_.size(); }
+
+	/// Runs the given job to completion, the calling thread participates.
+	/// Must only be called with submitMutex_ held (see tryAcquire).
+	void run(Job& job) {
+		{
+			auto lock = std::lock_guard(mutex_);
+			job_ = &job;
+			++generation_;
+		}
+
+		cv_.notify_all();
+		insideJob() = true;
+		runChunks(job);
+		insideJob() = false;
+
+		auto lock = std::unique_lock(mutex_);
+		cvDone_.wait(lock, [&]{ return job.active == 0; });
+		job_ = nullptr;
+	}
+
+	/// Tries to claim the single job slot. Returns false if another
+	/// thread currently runs a job; callers then process serially.
+	bool tryAcquire() { return submitMutex_.try_lock(); }
+	void release() { submitMutex_.unlock(); }
+
+private:
+	ParallelPool() {
+		auto count = std::thread::hardware_concurrency();
+		threads_.reserve(count > 1 ? count - 1 : 0);
+		for(auto i = 0u; count > 1 && i < count - 1; ++i) {
+			threads_.emplace_back([this]{ workerMain(); });
+		}
+	}
+
+	~ParallelPool() {
+		{
+			auto lock = std::lock_guard(mutex_);
+			stop_ = true;
+		}
+
+		cv_.notify_all();
+		for(auto& thread : threads_) {
+			thread.join();
+		}
+	}
+
+	static void runChunks(Job& job) {
+		while(true) {
+			auto begin = job.next.fetch_add(job.grain,
+				std::memory_order_relaxed);
+			if(begin >= job.end) {
+				break;
+			}
+
+			job.run(job, begin, std::min(begin + job.grain, job.end));
+		}
+	}
+
+	void workerMain() {
+		insideJob() = true;
+		auto seen = 0u;
+		auto lock = std::unique_lock(mutex_);
+		while(true) {
+			cv_.wait(lock, [&]{ return stop_ || generation_ != seen; });
+			if(stop_) {
+				return;
+			}
+
+			seen = generation_;
+			if(!job_) { // job already retired, we woke up late
+				continue;
+			}
+
+			auto& job = *job_;
+			++job.active;
+			lock.unlock();
+
+			runChunks(job);
+
+			lock.lock();
+			if(--job.active == 0) {
+				cvDone_.notify_one();
+			}
+		}
+	}
+
+	std::vector<std::thread> threads_;
+	std::mutex mutex_;
+	std::mutex submitMutex_;
+	std::condition_variable cv_;
+	std::condition_variable cvDone_;
+	Job* job_ {};
+	unsigned generation_ {};
+	bool stop_ {};
+};
+
+/// Calls func(begin, end) for consecutive chunks of [0, count), spread
+/// over the pool. Falls back to one serial call when the pool has no
+/// workers, is busy with another job or we are already inside one.
+template<typename F>
+void parallelChunks(std::size_t count, std::size_t grain, F&& func) {
+	if(count == 0) {
+		return;
+	}
+
+	auto& pool = ParallelPool::instance();
+	if(grain == 0) {
+		grain = std::max<std::size_t>(1,
+			count / (8 * (pool.workerCount() + 1)));
+	}
+
+	if(count <= grain || pool.workerCount() == 0 ||
+			ParallelPool::insideJob() || !pool.tryAcquire()) {
+		func(std::size_t(0), count);
+		return;
+	}
+
+	ParallelPool::Job job;
+	job.impl = &func;
+	job.end = count;
+	job.grain = grain;
+	job.run = [](ParallelPool::Job& j, std::size_t begin, std::size_t end) {
+		(*static_cast<std::remove_reference_t<F>*>(j.impl))(begin, end);
+	};
+
+	pool.run(job);
+	pool.release();
+}
+
+} // namespace detail
+
+/// Calls func for every element of the given span, parallelized over
+/// a shared, lazily created thread pool. The calling thread participates.
+/// func must be safe to call concurrently for distinct elements.
+/// grain is the number of elements handed out to a thread at once;
+/// 0 picks a default from the span size and the core count.
+/// Nested calls (from inside func) simply run serially.
+template<typename T, typename F>
+void parallelFor(span<T> data, F&& func, std::size_t grain = 0) {
+	detail::parallelChunks(data.size(), grain,
+		[&](std::size_t begin, std::size_t end) {
+			for(auto i = begin; i < end; ++i) {
+				func(data[i]);
+			}
+		});
+}
+
+/// Writes func(src[i]) to dst[i] for all elements, parallelized.
+/// Expects dst to be at least as large as src and not to alias it
+/// in a way func cannot handle. See parallelFor for grain semantics.
+template<typename T, typename U, typename F>
+void parallelTransform(span<T> src, span<U> dst, F&& func,
+		std::size_t grain = 0) {
+	detail::parallelChunks(src.size(), grain,
+		[&](std::size_t begin, std::size_t end) {
+			for(auto i = begin; i < end; ++i) {
+				dst[i] = func(src[i]);
+			}
+		});
+}
+
+/// Parallel reduction: func(chunk, init) is called for consecutive
+/// sub-spans and must return the chunk's partial result, the partials
+/// are merged with combine(acc, partial). combine must be associative
+/// and init its identity, the merge order is unspecified.
+/// ```cpp
+/// auto sum = nytl::parallelReduce(values, 0.0,
+/// 	[](nytl::span<const double> chunk, double acc) {
+/// 		for(auto& val : chunk) acc += val;
+/// 		return acc;
+/// 	}, std::plus<> {});
+/// ```
+template<typename T, typename R, typename F, typename C>
+R parallelReduce(span<T> data, R init, F&& func, C&& combine,
+		std::size_t grain = 0) {
+	auto result = init;
+	std::mutex mutex;
+	detail::parallelChunks(data.size(), grain,
+		[&](std::size_t begin, std::size_t end) {
+			auto partial = func(data.subspan(begin, end - begin), init);
+			auto lock = std::lock_guard(mutex);
+			result = combine(std::move(result), std::move(partial));
+		});
+
+	return result;
+}
+
+} // namespace nytl
+
+#endif // header guard
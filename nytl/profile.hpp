@@ -0,0 +1,223 @@
+// Copyright (c) 2017-2020 nyorain
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt
+
+/// \file Lightweight scoped profiling instrumentation.
+
+#pragma once
+
+#ifndef NYTL_INCLUDE_PROFILE
+#define NYTL_INCLUDE_PROFILE
+
+#include <atomic> // std::atomic
+#include <chrono> // std::chrono::steady_clock
+#include <cstdint> // std::uint64_t
+#include <map> // std::map
+#include <mutex> // std::mutex
+#include <ostream> // std::ostream
+#include <string> // std::string
+#include <vector> // std::vector
+
+// Compile-time kill switch. When defined to 0 (e.g. for release builds),
+// ScopeTimer and the NYTL_PROFILE_* macros compile down to nothing.
+#ifndef NYTL_PROFILE_ENABLE
+	#define NYTL_PROFILE_ENABLE 1
+#endif
+
+namespace nytl {
+namespace profile {
+
+/// A single recorded event. Scope entries carry the scope name, scope
+/// exits a null name; counter events additionally carry a value.
+/// Names must be string literals (or otherwise outlive the profiler),
+/// only the pointer is stored.
+struct Event {
+	const char* name; // nullptr: scope exit
+	std::uint64_t time; // steady_clock nanoseconds
+	std::int64_t counter; // only meaningful for counter events
+	bool isCounter;
+};
+
+inline std::uint64_t now() {
+	using namespace std::chrono;
+	auto dur = steady_clock::now().time_since_epoch();
+	return duration_cast<nanoseconds>(dur).count();
+}
+
+/// Per-thread event ring buffer. The owning thread writes without any
+/// synchronization besides a release store of the head; dump() reads
+/// concurrently with an acquire load and may therefore see a slightly
+/// stale tail. Events published before that head are fully visible,
+/// but once the ring wraps, record() overwrites old slots while a
+/// dump may still be reading them, so wrapped-over events can be torn
+/// or mixed. Dumps are best taken while the profiled threads are
+/// paused, or sized so the ring does not wrap between dumps.
+class ThreadBuffer {
+public:
+	static constexpr auto capacity = std::size_t(16 * 1024); // power of two
+
+public:
+	ThreadBuffer();
+	~ThreadBuffer();
+
+	void record(const Event& event) {
+		auto head = head_.load(std::memory_order_relaxed);
+		events_[head % capacity] = event;
+		head_.store(head + 1, std::memory_order_release);
+	}
+
+	std::vector<Event> events_ {};
+	std::atomic<std::uint64_t> head_ {0};
+};
+
+/// Global registry of the per-thread buffers, only locked on thread
+/// creation/destruction and for dumping, never on the recording path.
+struct Registry {
+	std::mutex mutex;
+	std::vector<ThreadBuffer*> buffers;
+
+	static Registry& instance() {
+		static Registry reg;
+		return reg;
+	}
+};
+
+inline ThreadBuffer::ThreadBuffer() : events_(capacity) {
+	auto& reg = Registry::instance();
+	auto lock = std::lock_guard(reg.mutex);
+	reg.buffers.push_back(this);
+}
+
+inline ThreadBuffer::~ThreadBuffer() {
+	auto& reg = Registry::instance();
+	auto lock = std::lock_guard(reg.mutex);
+	for(auto it = reg.buffers.begin(); it != reg.buffers.end(); ++it) {
+		if(*it == this) {
+			reg.buffers.erase(it);
+			break;
+		}
+	}
+}
+
+inline ThreadBuffer& threadBuffer() {
+	static thread_local ThreadBuffer buffer;
+	return buffer;
+}
+
+inline void counter(const char* name, std::int64_t value) {
+	threadBuffer().record({name, now(), value, true});
+}
+
+/// Replays all recorded events and writes aggregated, flame-graph-friendly
+/// output to the given stream: one folded-stack line per distinct scope
+/// path ("outer;inner <self-nanoseconds> <count>"), followed by one
+/// "# <name> <sum>" line per named counter. Concurrently recording
+/// threads are not stopped; their newest events may be missed.
+inline void dump(std::ostream& os) {
+	auto& reg = Registry::instance();
+	auto lock = std::lock_guard(reg.mutex);
+
+	std::map<std::string, std::pair<std::uint64_t, std::uint64_t>> scopes;
+	std::map<std::string, std::int64_t> counters;
+
+	for(auto& buffer : reg.buffers) {
+		auto head = buffer->head_.load(std::memory_order_acquire);
+		auto begin = head > ThreadBuffer::capacity ?
+			head - ThreadBuffer::capacity : 0u;
+
+		struct Frame {
+			std::string path;
+			std::uint64_t start;
+			std::uint64_t childTime; // spent in already-finished children
+		};
+
+		std::vector<Frame> stack;
+		for(auto i = begin; i < head; ++i) {
+			auto& event = buffer->events_[i % ThreadBuffer::capacity];
+			if(event.isCounter) {
+				counters[event.name] += event.counter;
+			} else if(event.name) {
+				auto path = stack.empty() ? std::string(event.name) :
+					stack.back().path + ";" + event.name;
+				stack.push_back({std::move(path), event.time, 0u});
+			} else if(!stack.empty()) { // exits without entry were evicted
+				auto total = event.time - stack.back().start;
+				auto& agg = scopes[stack.back().path];
+				agg.first += total - stack.back().childTime;
+				++agg.second;
+				stack.pop_back();
+				if(!stack.empty()) {
+					stack.back().childTime += total;
+				}
+			}
+		}
+	}
+
+	for(auto& [path, agg] : scopes) {
+		os << path << " " << agg.first << " " << agg.second << "\n";
+	}
+
+	for(auto& [name, sum] : counters) {
+		os << "# " << name << " " << sum << "\n";
+	}
+}
+
+} // namespace profile
+
+/// \brief Records the time spent in the current scope, sibling of ScopeGuard.
+/// On construction writes a scope-entry event, on destruction a scope-exit
+/// event into the calling thread's ring buffer; profile::dump() later folds
+/// matching pairs into per-path self times. The name must be a string
+/// literal. Usually used through the NYTL_PROFILE_SCOPE macro, which
+/// vanishes entirely when NYTL_PROFILE_ENABLE is defined to 0.
+/// ```cpp
+/// void emit() {
+/// 	auto timer = nytl::ScopeTimer("Callback::emit");
+/// 	// ... hot path ...
+/// }
+/// ```
+#if NYTL_PROFILE_ENABLE
+
+class ScopeTimer {
+public:
+	ScopeTimer(const char* name) {
+		profile::threadBuffer().record({name, profile::now(), 0, false});
+	}
+
+	ScopeTimer(ScopeTimer&&) = delete;
+	ScopeTimer& operator =(ScopeTimer&&) = delete;
+
+	~ScopeTimer() {
+		profile::threadBuffer().record({nullptr, profile::now(), 0, false});
+	}
+};
+
+#else // NYTL_PROFILE_ENABLE
+
+class ScopeTimer {
+public:
+	ScopeTimer(const char*) {}
+	ScopeTimer(ScopeTimer&&) = delete;
+	ScopeTimer& operator =(ScopeTimer&&) = delete;
+};
+
+#endif // NYTL_PROFILE_ENABLE
+
+} // namespace nytl
+
+// two-level concat so __LINE__ expands before it is pasted, giving
+// every NYTL_PROFILE_SCOPE in a scope a distinct timer name
+#define NYTL_PROFILE_CAT_IMPL(a, b) a ## b
+#define NYTL_PROFILE_CAT(a, b) NYTL_PROFILE_CAT_IMPL(a, b)
+
+#if NYTL_PROFILE_ENABLE
+	#define NYTL_PROFILE_SCOPE(name) \
+		::nytl::ScopeTimer NYTL_PROFILE_CAT(nytlProfileScopeTimer_, __LINE__)(name)
+	#define NYTL_PROFILE_COUNTER(name, value) \
+		::nytl::profile::counter(name, value)
+#else
+	#define NYTL_PROFILE_SCOPE(name)
+	#define NYTL_PROFILE_COUNTER(name, value) ((void) 0)
+#endif
+
+#endif // header guard
@@ -6,6 +6,7 @@
 #include <nytl/vec.hpp>
 #include <nytl/vecOps.hpp>
 #include <nytl/mat.hpp>
+#include <nytl/span.hpp>
 
 // Simple, lightweight and independent Quaternion implementation.
 // Mostly put together from snippets and implementation notes on the internet.
@@ -271,7 +272,7 @@ template<typename T>
 }
 
 [[nodiscard]] inline double dot(const Quaternion& a, const Quaternion& b) {
-	return a.x * b.x + a.y * b.y + a.z * b.y * a.w * b.y;
+	return a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w;
 }
 
 // https://en.wikipedia.org/wiki/Slerp
@@ -285,10 +286,10 @@ template<typename T>
     // the negation is applied to all four components. Fix by
     // reversing one quaternion.
     if (d < 0.0f) {
-        v1.x = v1.x;
-        v1.y = v1.y;
-        v1.z = v1.z;
-        v1.w = v1.w;
+        v1.x = -v1.x;
+        v1.y = -v1.y;
+        v1.z = -v1.z;
+        v1.w = -v1.w;
         d = -d;
     }
 
@@ -311,6 +312,117 @@ template<typename T>
     return (s0 * v0) + (s1 * v1);
 }
 
+// Normalized linear interpolation between the given quaternions.
+// Much cheaper than slerp since it needs no trigonometry, but does not
+// interpolate with constant angular velocity; commonly good enough
+// when the angle between the quaternions is small.
+// Assumes a and b to be normalized, takes the shorter path.
+[[nodiscard]] inline Quaternion nlerp(const Quaternion& a, Quaternion b, double t) {
+	if(dot(a, b) < 0.0) {
+		b = -1.0 * b;
+	}
+
+	return normalized(a + t * (b - a));
+}
+
+// Exponential of a pure (w == 0) quaternion.
+[[nodiscard]] inline Quaternion exp(const Quaternion& q) {
+	auto angle = std::sqrt(q.x * q.x + q.y * q.y + q.z * q.z);
+	if(angle <= 0.0) {
+		return {0.0, 0.0, 0.0, 1.0};
+	}
+
+	auto f = std::sin(angle) / angle;
+	return {f * q.x, f * q.y, f * q.z, std::cos(angle)};
+}
+
+// Logarithm of a unit quaternion, returns a pure (w == 0) quaternion.
+[[nodiscard]] inline Quaternion log(const Quaternion& q) {
+	auto vlen = std::sqrt(q.x * q.x + q.y * q.y + q.z * q.z);
+	if(vlen <= 0.0) {
+		return {0.0, 0.0, 0.0, 0.0};
+	}
+
+	auto f = std::atan2(vlen, q.w) / vlen;
+	return {f * q.x, f * q.y, f * q.z, 0.0};
+}
+
+// Intermediate control point for squad spline interpolation through
+// the rotation 'cur' with the given neighbor keyframes.
+// All quaternions are assumed to be normalized.
+[[nodiscard]] inline Quaternion squadControl(const Quaternion& prev,
+		const Quaternion& cur, const Quaternion& next) {
+	auto inv = conjugated(cur);
+	auto l = log(inv * prev) + log(inv * next);
+	return cur * exp(-0.25 * l);
+}
+
+// Spherical spline interpolation (squad) between q0 and q1 with the
+// control points a and b (see squadControl), t in [0, 1].
+// All quaternions are assumed to be normalized.
+[[nodiscard]] inline Quaternion squad(const Quaternion& q0, const Quaternion& a,
+		const Quaternion& b, const Quaternion& q1, double t) {
+	return slerp(slerp(q0, q1, t), slerp(a, b, t), 2.0 * t * (1.0 - t));
+}
+
+// - batch interpolation kernels -
+// The batch overloads below interpolate whole spans of quaternion
+// pairs at once, e.g. for blending skeleton poses. All spans must have
+// the same size, out may alias one of the inputs.
+
+// Batch nlerp with a shared interpolation factor.
+// The loop body is branchless (sign flip via copysign), so it
+// vectorizes across the quaternion components.
+inline void nlerp(span<const Quaternion> a, span<const Quaternion> b,
+		double t, span<Quaternion> out) {
+	assert(a.size() == b.size() && a.size() == out.size());
+	for(auto i = 0u; i < a.size(); ++i) {
+		auto s = std::copysign(1.0, dot(a[i], b[i]));
+		out[i] = normalized(a[i] + t * (s * b[i] - a[i]));
+	}
+}
+
+// Batch nlerp with per-element interpolation factors.
+inline void nlerp(span<const Quaternion> a, span<const Quaternion> b,
+		span<const double> t, span<Quaternion> out) {
+	assert(a.size() == b.size() && a.size() == t.size() && a.size() == out.size());
+	for(auto i = 0u; i < a.size(); ++i) {
+		auto s = std::copysign(1.0, dot(a[i], b[i]));
+		out[i] = normalized(a[i] + t[i] * (s * b[i] - a[i]));
+	}
+}
+
+// Batch slerp with a shared interpolation factor.
+// Pairs whose angle is below the slerp threshold take the trig-free
+// nlerp path, only the remaining ones pay for acos/sin.
+inline void slerp(span<const Quaternion> a, span<const Quaternion> b,
+		double t, span<Quaternion> out) {
+	assert(a.size() == b.size() && a.size() == out.size());
+	for(auto i = 0u; i < a.size(); ++i) {
+		out[i] = slerp(a[i], b[i], t);
+	}
+}
+
+// Batch slerp with per-element interpolation factors.
+inline void slerp(span<const Quaternion> a, span<const Quaternion> b,
+		span<const double> t, span<Quaternion> out) {
+	assert(a.size() == b.size() && a.size() == t.size() && a.size() == out.size());
+	for(auto i = 0u; i < a.size(); ++i) {
+		out[i] = slerp(a[i], b[i], t[i]);
+	}
+}
+
+// Batch squad with a shared interpolation factor.
+inline void squad(span<const Quaternion> q0, span<const Quaternion> a,
+		span<const Quaternion> b, span<const Quaternion> q1,
+		double t, span<Quaternion> out) {
+	assert(q0.size() == a.size() && q0.size() == b.size());
+	assert(q0.size() == q1.size() && q0.size() == out.size());
+	for(auto i = 0u; i < q0.size(); ++i) {
+		out[i] = squad(q0[i], a[i], b[i], q1[i], t);
+	}
+}
+
 // Sequences of rotation around axes.
 // https://en.wikipedia.org/wiki/Euler_angles
 enum class RotationSequence {
@@ -0,0 +1,249 @@
+// Copyright (c) 2017-2020 nyorain
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt
+
+/// \file Defines the RectIndex template class, a spatial index over Rects.
+
+#pragma once
+
+#ifndef NYTL_INCLUDE_RECT_INDEX
+#define NYTL_INCLUDE_RECT_INDEX
+
+#include <nytl/rect.hpp> // nytl::Rect
+#include <nytl/rectOps.hpp> // nytl::intersectsMask
+#include <nytl/vecOps.hpp> // nytl::vec::cw::min
+#include <nytl/span.hpp> // nytl::span
+
+#include <vector> // std::vector
+#include <algorithm> // std::nth_element
+#include <cstdint> // std::uint32_t
+#include <cassert> // assert
+
+namespace nytl {
+
+/// A packed bounding volume hierarchy over a set of Rects, e.g. for
+/// hit testing many windows or widgets. Built once from a span of
+/// Rects (bulk load, median split along the widest axis), all nodes
+/// and reordered rects live in contiguous arrays. Queries descend the
+/// hierarchy and test whole leaves at once with the batch predicates
+/// from nytl/rectOps.hpp, writing matching rect ids into a caller
+/// provided buffer.
+template<std::size_t D, typename T>
+class RectIndex {
+public:
+	using Rect = nytl::Rect<D, T>;
+	using Vec = nytl::Vec<D, T>;
+	using ID = std::uint32_t;
+	static constexpr std::size_t leafSize = 16;
+
+public:
+	RectIndex() = default;
+	explicit RectIndex(span<const Rect> rects) { build(rects); }
+
+	/// (Re-)builds the index over the given rects.
+	/// Query results refer to positions in this span.
+	void build(span<const Rect> rects) {
+		clear();
+		if(rects.empty()) {
+			return;
+		}
+
+		rects_.assign(rects.begin(), rects.end());
+		ids_.resize(rects.size());
+		for(auto i = ID {0}; i < ids_.size(); ++i) {
+			ids_[i] = i;
+		}
+
+		nodes_.reserve(2 * (rects.size() / leafSize + 1));
+		buildNode(0u, ID(rects.size()));
+	}
+
+	/// Writes the ids of all rects containing the given point into
+	/// 'out'. Returns the number of matches; at most out.size() ids
+	/// are written, further matches are counted but dropped.
+	std::size_t query(const Vec& point, span<ID> out) const {
+		auto count = std::size_t {0};
+		traverse(
+			[&](const Rect& b) { return contains(b, point); },
+			[&](ID begin, ID n) {
+				for(auto i = begin; i < begin + n; ++i) {
+					if(contains(rects_[i], point)) {
+						count = write(ids_[i], out, count);
+					}
+				}
+			});
+
+		return count;
+	}
+
+	/// Writes the ids of all rects intersecting the given area into
+	/// 'out', like the point overload. Touching counts as intersection.
+	/// Whole leaves are tested at once via intersectsMask.
+	std::size_t query(const Rect& area, span<ID> out) const {
+		static_assert(leafSize <= 64);
+		auto count = std::size_t {0};
+		traverse(
+			[&](const Rect& b) { return intersects(b, area); },
+			[&](ID begin, ID n) {
+				std::uint64_t mask[1] {};
+				intersectsMask(area, span<const Rect>(rects_.data() + begin, n),
+					span<std::uint64_t>(mask, 1));
+				for(auto bits = mask[0]; bits; bits &= bits - 1) {
+					auto i = begin + bitIndex(bits);
+					count = write(ids_[i], out, count);
+				}
+			});
+
+		return count;
+	}
+
+	/// Returns whether any indexed rect intersects the given area.
+	[[nodiscard]] bool any(const Rect& area) const {
+		ID id;
+		return query(area, span<ID>(&id, 1)) > 0;
+	}
+
+	/// The indexed rects, reordered for locality.
+	[[nodiscard]] span<const Rect> rects() const { return rects_; }
+
+	[[nodiscard]] std::size_t size() const { return rects_.size(); }
+	[[nodiscard]] bool empty() const { return rects_.empty(); }
+
+	void clear() {
+		nodes_.clear();
+		rects_.clear();
+		ids_.clear();
+	}
+
+protected:
+	// Inner nodes store the index of their first child (children are
+	// adjacent), leaves a range of the reordered rect array.
+	struct Node {
+		Rect bounds;
+		ID begin; // leaf: first rect; inner: first child node
+		ID count; // leaf: rect count; inner: 0
+	};
+
+	Rect boundsOf(ID begin, ID end) const {
+		auto min = rects_[begin].position;
+		auto max = rects_[begin].position + rects_[begin].size;
+		for(auto i = begin + 1; i < end; ++i) {
+			min = vec::cw::min(min, rects_[i].position);
+			max = vec::cw::max(max, rects_[i].position + rects_[i].size);
+		}
+
+		return {min, max - min};
+	}
+
+	ID buildNode(ID begin, ID end) {
+		auto id = ID(nodes_.size());
+		nodes_.push_back({boundsOf(begin, end), begin, end - begin});
+
+		if(end - begin <= leafSize) {
+			return id;
+		}
+
+		// median split along the widest axis of the node bounds
+		auto axis = 0u;
+		auto& bounds = nodes_[id].bounds;
+		for(auto i = 1u; i < D; ++i) {
+			if(bounds.size[i] > bounds.size[axis]) {
+				axis = i;
+			}
+		}
+
+		auto mid = begin + (end - begin) / 2;
+		auto center = [axis](const Rect& r) {
+			return r.position[axis] + r.size[axis] / T {2};
+		};
+
+		// reorder rects and ids together
+		std::vector<ID> order(end - begin);
+		for(auto i = 0u; i < order.size(); ++i) {
+			order[i] = begin + i;
+		}
+
+		std::nth_element(order.begin(), order.begin() + (mid - begin), order.end(),
+			[&](ID a, ID b) { return center(rects_[a]) < center(rects_[b]); });
+		applyOrder(begin, order);
+
+		// the left child directly follows its parent, so inner nodes
+		// only need to store the id of their right child
+		buildNode(begin, mid);
+		auto right = buildNode(mid, end);
+		nodes_[id].begin = right;
+		nodes_[id].count = 0;
+		return id;
+	}
+
+	void applyOrder(ID begin, span<const ID> order) {
+		std::vector<Rect> rtmp(order.size());
+		std::vector<ID> itmp(order.size());
+		for(auto i = 0u; i < order.size(); ++i) {
+			rtmp[i] = rects_[order[i]];
+			itmp[i] = ids_[order[i]];
+		}
+
+		std::copy(rtmp.begin(), rtmp.end(), rects_.begin() + begin);
+		std::copy(itmp.begin(), itmp.end(), ids_.begin() + begin);
+	}
+
+	// Descends the hierarchy, pruning subtrees whose bounds fail
+	// 'bounds'; 'leaf' is called with each surviving leaf rect range.
+	template<typename B, typename L>
+	void traverse(B&& bounds, L&& leaf) const {
+		if(nodes_.empty()) {
+			return;
+		}
+
+		ID stack[64];
+		auto top = 0u;
+		stack[top++] = 0u;
+
+		while(top > 0) {
+			auto id = stack[--top];
+			auto& node = nodes_[id];
+			if(!bounds(node.bounds)) {
+				continue;
+			}
+
+			if(node.count > 0) { // leaf
+				leaf(node.begin, node.count);
+			} else { // inner: left child is id + 1, right child stored
+				assert(top + 2 <= 64u);
+				stack[top++] = id + 1;
+				stack[top++] = node.begin;
+			}
+		}
+	}
+
+	static unsigned bitIndex(std::uint64_t bits) {
+#if defined(__GNUC__) || defined(__clang__)
+		return __builtin_ctzll(bits);
+#else
+		auto i = 0u;
+		for(; !(bits & 1); bits >>= 1) ++i;
+		return i;
+#endif
+	}
+
+	std::size_t write(ID id, span<ID> out, std::size_t count) const {
+		if(count < out.size()) {
+			out[count] = id;
+		}
+
+		return count + 1;
+	}
+
+	std::vector<Node> nodes_;
+	std::vector<Rect> rects_; // reordered for leaf locality
+	std::vector<ID> ids_; // original positions of the reordered rects
+};
+
+using RectIndex2f = RectIndex<2, float>;
+using RectIndex2i = RectIndex<2, int>;
+using RectIndex3f = RectIndex<3, float>;
+
+} // namespace nytl
+
+#endif // header guard
@@ -13,10 +13,15 @@
 #include <nytl/rect.hpp> // nytl::Rect
 #include <nytl/vecOps.hpp> // nytl::sum
 #include <nytl/simplex.hpp> // nytl::Simplex
+#include <nytl/span.hpp> // nytl::span
+#include <nytl/staticVector.hpp> // nytl::StaticVector
 
 #include <utility> // std::pair
 #include <vector> // std::vector
+#include <array> // std::array
 #include <iosfwd> // std::ostream
+#include <cstdint> // std::uint64_t
+#include <cassert> // assert
 
 namespace nytl {
 
@@ -41,6 +46,30 @@ std::ostream& operator<<(std::ostream& os, const Rect<D, T>& rect) {
 	return print(os, rect);
 }
 
+/// \brief Formats the given Rect into the given character buffer.
+/// Uses std::to_chars via nytl::format(span<char>, Vec), i.e. no
+/// allocations or locale machinery; writes the same "{(pos)(size)}"
+/// representation as print.
+/// Returns the number of characters written, 0 if the buffer was too small.
+/// \module rectOps
+template<std::size_t D, typename T>
+std::size_t format(span<char> buf, const Rect<D, T>& rect) {
+	auto rest = buf;
+	auto ok = true;
+	detail::formatAppend(rest, std::string_view("{"), ok);
+
+	auto written = format(rest, rect.position);
+	ok = ok && written != 0;
+	rest = rest.last(rest.size() - written);
+
+	written = format(rest, rect.size);
+	ok = ok && written != 0;
+	rest = rest.last(rest.size() - written);
+
+	detail::formatAppend(rest, std::string_view("}"), ok);
+	return ok ? buf.size() - rest.size() : 0;
+}
+
 /// \brief Tests two rects for equality.
 /// They are equal when their position and size vectors are equal.
 /// \module rectOps
@@ -103,8 +132,12 @@ constexpr bool containsReal(const Rect<D, T1>& rect, const Vec<D, T2>& point) {
 /// \module rectOps
 template<std::size_t D, typename T1, typename T2>
 constexpr bool intersects(const Rect<D, T1>& a, const Rect<D, T2>& b) {
-	return contains(a, b.position) || contains(a, b.position + b.size) ||
-		contains(b, a.position) || contains(b, a.position + a.size);
+	for(auto i = 0u; i < D; ++i) {
+		if(b.position[i] > a.position[i] + a.size[i]) return false;
+		if(a.position[i] > b.position[i] + b.size[i]) return false;
+	}
+
+	return true;
 }
 
 /// \brief Returns whether the the two given Rects intersect.
@@ -113,8 +146,12 @@ constexpr bool intersects(const Rect<D, T1>& a, const Rect<D, T2>& b) {
 /// \module rectOps
 template<std::size_t D, typename T1, typename T2>
 constexpr bool intersectsReal(const Rect<D, T1>& a, const Rect<D, T2>& b) {
-	return containsReal(a, b.position) || containsReal(a, b.position + b.size) ||
-		containsReal(b, a.position) || containsReal(b, a.position + a.size);
+	for(auto i = 0u; i < D; ++i) {
+		if(b.position[i] >= a.position[i] + a.size[i]) return false;
+		if(a.position[i] >= b.position[i] + b.size[i]) return false;
+	}
+
+	return true;
 }
 
 /// \brief Returns the intersection between the given Rects.
@@ -137,21 +174,21 @@ constexpr Rect<D, T> intersection(const Rect<D, T>& a, const Rect<D, T>& b) {
 
 /// \brief Returns the difference of the first Rect to the second Rect (a -b).
 /// Effectively returns the parts of the first Rect that are not part of the second one.
-/// Returns the resulting Rects as a vector since the count depends on the layout
-/// of the Rects. If the Rects have no intersection, just returns a vector with
-/// only the first Rect and if they are the same, returns an empty vector.
+/// Returns at most 2 * D Rects since the count depends on the layout
+/// of the Rects, inline in a StaticVector so no allocation happens.
+/// If the Rects have no intersection, just returns only the first Rect
+/// and if they are the same, returns an empty vector.
 /// \notes This operations is not symmetric, i.e. difference(a, b) != difference(b, a).
 /// \notes Also see [nytl::rectOps::symmetricDifference]().
 /// In general is symmetricDifference(a, b) = difference(a, b) | difference(b, a);
 /// \module rectOps
 template<std::size_t D, class T>
-std::vector<Rect<D, T>> difference(const Rect<D, T>& a, const Rect<D, T>& b) {
+StaticVector<Rect<D, T>, 2 * D> difference(const Rect<D, T>& a, const Rect<D, T>& b) {
 	static constexpr auto inRange = [](T start, T size, T value) {
 		return (start < value && value < start + size);
 	};
 
-	std::vector<Rect<D, T>> ret;
-	ret.reserve(2 * D);
+	StaticVector<Rect<D, T>, 2 * D> ret;
 
 	for(std::size_t i(0); i < D; ++i) {
 
@@ -159,10 +196,12 @@ std::vector<Rect<D, T>> difference(const Rect<D, T>& a, const Rect<D, T>& b) {
 		if(inRange(a.position[i], a.size[i], b.position[i])) {
 			auto pos = a.position;
 			for(std::size_t o(0); o < i; ++o)
-				pos[o] = b.position[o];
+				pos[o] = std::max(b.position[o], a.position[o]);
 
 			auto size = (a.position + a.size) - pos;
 			size[i] = b.position[i] - pos[i];
+			for(std::size_t o(0); o < i; ++o)
+				size[o] = std::min(size[o], (b.position[o] + b.size[o]) - pos[o]);
 
 			ret.push_back({pos, size});
 		}
@@ -177,7 +216,7 @@ std::vector<Rect<D, T>> difference(const Rect<D, T>& a, const Rect<D, T>& b) {
 
 			auto size = (a.position + a.size) - pos;
 			for(std::size_t o(0); o < i; ++o)
-				size[o] = (b.position[o] + b.size[o]) - pos[o];
+				size[o] = std::min(size[o], (b.position[o] + b.size[o]) - pos[o]);
 
 			ret.push_back({pos, size});
 		}
@@ -186,6 +225,162 @@ std::vector<Rect<D, T>> difference(const Rect<D, T>& a, const Rect<D, T>& b) {
 	return ret;
 }
 
+/// \brief Planar (structure-of-arrays) pack of Rects for batch tests.
+/// Stores the begin and end coordinates of the packed rects per axis in
+/// contiguous arrays, so the batch predicates below compare one plane
+/// at a time and the inner loops vectorize.
+/// \module rectOps
+template<std::size_t D, typename T>
+struct RectPack {
+	std::array<std::vector<T>, D> begin; // position, per axis
+	std::array<std::vector<T>, D> end; // position + size, per axis
+
+	RectPack() = default;
+	RectPack(span<const Rect<D, T>> rects) {
+		for(auto i = 0u; i < D; ++i) {
+			begin[i].reserve(rects.size());
+			end[i].reserve(rects.size());
+		}
+
+		for(auto& rect : rects) {
+			add(rect);
+		}
+	}
+
+	void add(const Rect<D, T>& rect) {
+		for(auto i = 0u; i < D; ++i) {
+			begin[i].push_back(rect.position[i]);
+			end[i].push_back(rect.position[i] + rect.size[i]);
+		}
+	}
+
+	std::size_t size() const { return begin[0].size(); }
+	bool empty() const { return begin[0].empty(); }
+	void clear() {
+		for(auto i = 0u; i < D; ++i) {
+			begin[i].clear();
+			end[i].clear();
+		}
+	}
+};
+
+/// \brief Returns whether the given Rect intersects any of the given Rects.
+/// Like intersects, touching counts as intersection.
+/// \module rectOps
+template<std::size_t D, typename T1, typename T2>
+constexpr bool intersectsAny(const Rect<D, T1>& a, span<const Rect<D, T2>> rects) {
+	for(auto& b : rects) {
+		if(intersects(a, b)) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/// \brief Returns whether the given Rect intersects all of the given Rects.
+/// Like intersects, touching counts as intersection.
+/// \module rectOps
+template<std::size_t D, typename T1, typename T2>
+constexpr bool intersectsAll(const Rect<D, T1>& a, span<const Rect<D, T2>> rects) {
+	for(auto& b : rects) {
+		if(!intersects(a, b)) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/// \brief Batch intersection test, writes one bit per given Rect.
+/// Bit i of the mask is set iff the given Rect intersects rects[i]
+/// (touching counts). The mask span must hold at least
+/// (rects.size() + 63) / 64 words, unused bits are cleared.
+/// The loop body is branchless, see the RectPack overload for a
+/// planar variant.
+/// \module rectOps
+template<std::size_t D, typename T1, typename T2>
+constexpr void intersectsMask(const Rect<D, T1>& a, span<const Rect<D, T2>> rects,
+		span<std::uint64_t> mask) {
+	assert(64 * mask.size() >= rects.size());
+	for(auto& word : mask) {
+		word = 0u;
+	}
+
+	auto aEnd = a.position + a.size;
+	for(auto i = std::size_t {0}; i < rects.size(); ++i) {
+		auto hit = true;
+		for(auto d = 0u; d < D; ++d) {
+			hit &= (a.position[d] <= rects[i].position[d] + rects[i].size[d]) &
+				(rects[i].position[d] <= aEnd[d]);
+		}
+
+		mask[i >> 6] |= std::uint64_t {hit} << (i & 63);
+	}
+}
+
+/// \brief Planar overload of intersectsMask for packed Rects.
+/// Compares one coordinate plane of the pack at a time, i.e. the inner
+/// loops run over contiguous arrays of a single component.
+/// \module rectOps
+template<std::size_t D, typename T1, typename T2>
+void intersectsMask(const Rect<D, T1>& a, const RectPack<D, T2>& rects,
+		span<std::uint64_t> mask) {
+	assert(64 * mask.size() >= rects.size());
+	auto words = (rects.size() + 63) / 64;
+	for(auto w = std::size_t {0}; w < words; ++w) {
+		mask[w] = ~std::uint64_t {0};
+	}
+
+	// like the scalar overload, words past the last rect are zeroed
+	for(auto w = words; w < mask.size(); ++w) {
+		mask[w] = 0u;
+	}
+
+	for(auto d = 0u; d < D; ++d) {
+		auto aBegin = a.position[d];
+		auto aEnd = a.position[d] + a.size[d];
+		auto& begin = rects.begin[d];
+		auto& end = rects.end[d];
+
+		for(auto i = std::size_t {0}; i < rects.size(); ++i) {
+			auto hit = (aBegin <= end[i]) & (begin[i] <= aEnd);
+			mask[i >> 6] &= ~(std::uint64_t {!hit} << (i & 63));
+		}
+	}
+
+	// clear the bits past the last rect
+	if(rects.size() & 63) {
+		mask[rects.size() >> 6] &=
+			(std::uint64_t {1} << (rects.size() & 63)) - 1;
+	}
+}
+
+/// \brief Batch containment test, writes one bit per given Rect.
+/// Bit i of the mask is set iff rects[i] lies completely inside the
+/// given Rect (the outline counts as inside, like contains).
+/// The mask span must hold at least (rects.size() + 63) / 64 words.
+/// \module rectOps
+template<std::size_t D, typename T1, typename T2>
+constexpr void containsMask(const Rect<D, T1>& a, span<const Rect<D, T2>> rects,
+		span<std::uint64_t> mask) {
+	assert(64 * mask.size() >= rects.size());
+	for(auto& word : mask) {
+		word = 0u;
+	}
+
+	auto aEnd = a.position + a.size;
+	for(auto i = std::size_t {0}; i < rects.size(); ++i) {
+		auto inside = true;
+		for(auto d = 0u; d < D; ++d) {
+			inside &= (a.position[d] <= rects[i].position[d]) &
+				(rects[i].position[d] + rects[i].size[d] <= aEnd[d]);
+		}
+
+		mask[i >> 6] |= std::uint64_t {inside} << (i & 63);
+	}
+}
+
 } // namespace nytl
 
 #endif // header guard
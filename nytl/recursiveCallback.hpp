@@ -14,7 +14,7 @@
 #include <nytl/scope.hpp> // nytl::ScopeGuard
 
 #include <functional> // std::function
-#include <forward_list> // std::forward_list
+#include <memory_resource> // std::pmr::polymorphic_allocator
 #include <utility> // std::move
 #include <cstdint> // std::uint64_t
 #include <cstddef> // std::size_t
@@ -26,8 +26,6 @@
 
 namespace nytl {
 
-// TODO (C++17): use std::pmr for more efficient memory allocations (?)
-
 /// List of callback functions.
 /// Everyone can register their functions in a callback object and
 /// then all registered functions together might be called.
@@ -36,6 +34,14 @@ namespace nytl {
 /// function that was called because the callback was called.
 /// So the callback might be accessed from inside such a function.
 /// If you don't need this functionality, just see nytl::Callback.
+/// Subscriptions live in one contiguous array, so an emission is a
+/// linear scan instead of a pointer chase. Removal during an active
+/// call only invalidates the slot (by negating its id), compaction
+/// is deferred until all emissions finished; functions added during
+/// an active call are kept aside and merged in afterwards, which
+/// also keeps the array stable while it is iterated.
+/// The backing memory comes from a std::pmr::memory_resource that
+/// can be passed at construction.
 /// The public interface of this class is identical with nytl::Callback
 /// so they can be used interchangeably.
 /// The class is not thread-safe in any way.
@@ -63,7 +69,11 @@ public:
 	using Signature = Ret(Args...);
 	using Connection = ConnectionT<ConnectableT<ID>, ID>;
 
-	RecursiveCallback() = default;
+	/// Constructs the callback, optionally with the memory resource
+	/// from which the subscription nodes are allocated.
+	/// The resource must stay valid for the lifetime of this object.
+	RecursiveCallback(std::pmr::memory_resource* memory =
+		std::pmr::get_default_resource()) : subs_(memory), pending_(memory) {}
 	~RecursiveCallback();
 
 	/// \brief Registers a new Callback function.
@@ -99,6 +109,9 @@ public:
 	/// callback is undefined behvaiour.
 	bool disconnect(const ID&) noexcept override;
 
+	/// The inherited bulk overload, would otherwise be name-hidden.
+	using ConnectableT<ID>::disconnect;
+
 	/// Operator version of add
 	template<typename F>
 	Connection operator+=(F&& func) {
@@ -124,13 +137,18 @@ protected:
 	// remove subscriptions from the outside without actively
 	// calling disconnect.
 	// We cannot touch func while any iteration is active.
-	// If the
 	struct Subscription {
 		std::function<Ret(Args...)> func;
 		ID id;
 	};
 
+	using Subs = std::vector<Subscription,
+		std::pmr::polymorphic_allocator<Subscription>>;
+
 	// Emplaces a new subscription for the given function.
+	// While an emission is active, the new subscription goes into
+	// pending_ so subs_ is never reallocated under an iteration
+	// (which would move function objects that may be executing).
 	Subscription& emplace() {
 		// output at least a warning when subID_ has to be wrapped
 		// Usually this should not happen. Bad things can happend then.
@@ -143,57 +161,49 @@ protected:
 		// our own state in any bad way
 		ID id = {subID_ + 1};
 
-		// emplace at the last position
 		// might also throw
-		if(subs_.empty()) {
-			subs_.emplace_front();
-			last_ = subs_.begin();
-		} else {
-			last_ = subs_.emplace_after(last_);
-		}
+		auto& list = iterationCount_ ? pending_ : subs_;
+		list.emplace_back();
 
 		++subID_;
-		last_->id = {id};
-		return *last_;
+		list.back().id = {id};
+		return list.back();
 	}
 
-	// Removes all old functions that could previously
-	// not be removed because of an active iteration.
+	// Compacts the subscription array: notifies and drops the slots
+	// invalidated during the pending iterations and merges in the
+	// subscriptions added since, keeping registration order.
+	// Must only be called while no iteration is active.
 	void removeOld() noexcept {
-		++iterationCount_;
+		auto out = subs_.begin();
+		for(auto& sub : subs_) {
+			if(sub.id.get() > 0) {
+				if(&*out != &sub) {
+					*out = std::move(sub);
+				}
 
-		// just remove subscriptions with id <= 0 and update last_
-		auto it = subs_.begin();
-		while(it != subs_.end() && it->id.get() <= 0) {
-			subs_.pop_front();
-			it = subs_.begin();
+				++out;
+			} else {
+				sub.id.removed();
+			}
 		}
 
-		if(it != subs_.end()) {
-			for(auto next = std::next(it); next != subs_.end(); next = std::next(it)) {
-				if(next->id.get() <= 0) {
-					next->id.removed();
-					subs_.erase_after(it);
-				} else {
-					++it;
-				}
-			}
+		subs_.erase(out, subs_.end());
+		for(auto& sub : pending_) {
+			subs_.push_back(std::move(sub));
 		}
 
-		last_ = it;
-		--iterationCount_;
+		pending_.clear();
 	}
 
-	// TODO: maybe cache current size for performance?
-
 	// Upper approximation of the current size.
 	// May be larger than the actual size.
 	std::size_t size() const {
-		return std::distance(subs_.begin(), subs_.end());
+		return subs_.size() + pending_.size();
 	}
 
-	std::forward_list<Subscription> subs_ {}; // all registered subscriptions
-	typename decltype(subs_)::iterator last_ {}; // the last entry in subs
+	Subs subs_; // emission slots, contiguous, ordered by id
+	Subs pending_; // added during an active emission, merged afterwards
 	unsigned int iterationCount_ {}; // the number of active iterations (in call)
 	std::int64_t subID_ {}; // the highest subscription id given
 	std::int64_t callID_ {}; // the highest call id given (see the call function)
@@ -213,6 +223,10 @@ RecursiveCallback<Ret(Args...), ID>::~RecursiveCallback()
 	for(auto& sub : subs_) {
 		sub.id.removed();
 	}
+
+	for(auto& sub : pending_) {
+		sub.id.removed();
+	}
 }
 
 template<typename Ret, typename... Args, typename ID>
@@ -251,9 +265,10 @@ auto RecursiveCallback<Ret(Args...), ID>::call(Args... a)
 	// there are 2^32 nested calls...)
 	callID_ = (callID_ == std::numeric_limits<std::int64_t>::max()) ? 1 : callID_ + 1;
 	std::int64_t callid = callID_; // the actual calling id (to include newly removed)
-	auto last = last_; // store it (to not iterate over newly added subs)
 
-	// make sure the no list iterators are invalidated while iterating
+	// we will not call functions registered after this call started;
+	// those end up in pending_ and subs_ does not grow under us
+	auto end = subs_.size();
 	++iterationCount_;
 
 	// make sure the iteration count and cleanup done if possible
@@ -265,31 +280,25 @@ auto RecursiveCallback<Ret(Args...), ID>::call(Args... a)
 	});
 
 	if constexpr(std::is_same<Ret, void>::value) {
-		for(auto it = subs_.begin(); it != subs_.end(); ++it) {
-			// if the first check if fasel, -it->id.get() represents the
+		for(auto i = std::size_t {0}; i < end; ++i) {
+			// if the first check is false, -id.get() represents the
 			// callID during which it was removed. If this is >= than
 			// the stored callID, it was removed during or after this
 			// call and therefore we still call it
-			if(it->id.get() > 0 || -it->id.get() >= callid) {
-				it->func(std::forward<Args>(a)...);
-				// we will not call functions that were registered after
-				// this call started (this is why we store last above)
-				if(it == last) {
-					break;
-				}
+			auto& sub = subs_[i];
+			if(sub.id.get() > 0 || -sub.id.get() >= callid) {
+				sub.func(std::forward<Args>(a)...);
 			}
 		}
 
 	} else { // the same with a return vector
 		std::vector<Ret> ret;
-		ret.reserve(size());
+		ret.reserve(end);
 
-		for(auto it = subs_.begin(); it != subs_.end(); ++it) {
-			if(it->id.get() > 0 || -it->id.get() >= callid) {
-				ret.push_back(it->func(std::forward<Args>(a)...));
-				if(it == last) {
-					break;
-				}
+		for(auto i = std::size_t {0}; i < end; ++i) {
+			auto& sub = subs_[i];
+			if(sub.id.get() > 0 || -sub.id.get() >= callid) {
+				ret.push_back(sub.func(std::forward<Args>(a)...));
 			}
 		}
 
@@ -311,11 +320,17 @@ void RecursiveCallback<Ret(Args...), ID>::clear() noexcept
 		}
 	}
 
+	// pending subscriptions were never iterated, they can always
+	// be removed directly
+	for(auto& sub : pending_) {
+		sub.id.removed();
+	}
+
+	pending_.clear();
+
 	// clear/remove only if no one is currently iterating
-	// we only reset end_ (not really needed, cleanup for easier debugging)
 	if(remove) {
 		subs_.clear();
-		last_ = subs_.end();
 	}
 }
 
@@ -323,50 +338,32 @@ void RecursiveCallback<Ret(Args...), ID>::clear() noexcept
 template<typename Ret, typename... Args, typename ID>
 bool RecursiveCallback<Ret(Args...), ID>::disconnect(const ID& id) noexcept
 {
-	if(subs_.empty())  {
-		return false;
-	}
-
 	auto remove = (iterationCount_ == 0);
-
-	// check for first one
-	if(subs_.begin()->id.get() == id.get()) {
-		if(remove) {
-			subs_.begin()->id.removed();
-			subs_.pop_front();
-			if(subs_.empty()) {
-				last_ = subs_.end();
-			}
-		} else {
-			subs_.begin()->id.set(-callID_);
-		}
-
-		return true;
-	}
-
-	// iterate through subs, always check the next elem (fwd linked list)
-	// the end condition constructs a copy of it and increases it to check
-	for(auto it = subs_.begin(); true; ++it) {
-		auto next = it;
-		if(++next == subs_.end())
-			break;
-
-		if(next->id.get() == id.get()) {
+	for(auto it = subs_.begin(); it != subs_.end(); ++it) {
+		if(it->id.get() == id.get()) {
 			if(remove) {
-				// set this before id.removed might change stuff
-				if(++next == subs_.end()) {
-					last_ = it;
-				}
-				next->id.removed();
-				subs_.erase_after(it);
+				it->id.removed();
+				subs_.erase(it);
 			} else {
-				next->id.set(-callID_);
+				// only invalidate the slot, compaction is deferred
+				// until the active iterations finished
+				it->id.set(-callID_);
 			}
 
 			return true;
 		}
 	}
 
+	// pending subscriptions were never iterated, they can always
+	// be removed directly
+	for(auto it = pending_.begin(); it != pending_.end(); ++it) {
+		if(it->id.get() == id.get()) {
+			it->id.removed();
+			pending_.erase(it);
+			return true;
+		}
+	}
+
 	return false;
 }
 
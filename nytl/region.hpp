@@ -0,0 +1,322 @@
+// Copyright (c) 2017-2020 nyorain
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt
+
+/// \file Defines the Region template class, a 2D rectangle set.
+
+#pragma once
+
+#ifndef NYTL_INCLUDE_REGION
+#define NYTL_INCLUDE_REGION
+
+#include <nytl/rect.hpp> // nytl::Rect
+#include <nytl/rectOps.hpp> // nytl::intersection
+#include <nytl/vecOps.hpp> // nytl::vec::cw::min
+#include <nytl/span.hpp> // nytl::span
+
+#include <vector> // std::vector
+#include <array> // std::array
+#include <algorithm> // std::sort
+#include <cassert> // assert
+
+namespace nytl {
+
+namespace detail {
+
+// Writes the pieces of 'a - b' into 'out' (capacity >= 4), returns
+// the number of written pieces. Same splitting logic as the
+// allocating difference() from nytl/rectOps.hpp, specialized for 2D.
+template<typename T>
+unsigned rectDifference(const Rect<2, T>& a, const Rect<2, T>& b,
+		Rect<2, T>* out) {
+	constexpr auto inRange = [](T start, T size, T value) {
+		return (start < value && value < start + size);
+	};
+
+	auto count = 0u;
+	for(auto i = 0u; i < 2u; ++i) {
+		// rect before intersection
+		if(inRange(a.position[i], a.size[i], b.position[i])) {
+			auto pos = a.position;
+			for(auto o = 0u; o < i; ++o)
+				pos[o] = std::max(b.position[o], a.position[o]);
+
+			auto size = (a.position + a.size) - pos;
+			size[i] = b.position[i] - pos[i];
+			for(auto o = 0u; o < i; ++o)
+				size[o] = std::min(size[o], (b.position[o] + b.size[o]) - pos[o]);
+
+			out[count++] = {pos, size};
+		}
+
+		// rect after intersection
+		if(inRange(a.position[i], a.size[i], b.position[i] + b.size[i])) {
+			auto pos = a.position;
+			pos[i] = b.position[i] + b.size[i];
+			for(auto o = 0u; o < i; ++o)
+				pos[o] = std::max(b.position[o], a.position[o]);
+
+			auto size = (a.position + a.size) - pos;
+			for(auto o = 0u; o < i; ++o)
+				size[o] = std::min(size[o], (b.position[o] + b.size[o]) - pos[o]);
+
+			out[count++] = {pos, size};
+		}
+	}
+
+	return count;
+}
+
+} // namespace detail
+
+/// A set of non-overlapping 2D rectangles, e.g. for damage tracking.
+/// The rects are kept y/x-sorted (band order) and horizontally
+/// adjacent rects of the same band are merged. Up to 8 rects are
+/// stored inline, so the common small-damage case never touches the
+/// heap; subtract and intersect never allocate at all, they split the
+/// stored rects in place using the difference() logic from
+/// nytl/rectOps.hpp.
+template<typename T>
+class Region {
+public:
+	using Rect = nytl::Rect<2, T>;
+	using Vec = nytl::Vec<2, T>;
+	static constexpr std::size_t inlineCapacity = 8;
+
+public:
+	Region() = default;
+	Region(const Rect& rect) {
+		if(!emptyRect(rect)) {
+			rects_.push_back(rect);
+		}
+	}
+
+	/// Adds the given rect to the region (union).
+	/// Only the parts not already covered are inserted, so the stored
+	/// rects stay non-overlapping. May allocate when the region grows
+	/// beyond the inline capacity.
+	void add(const Rect& rect) {
+		if(emptyRect(rect)) {
+			return;
+		}
+
+		// split the new rect against every stored rect, keeping only
+		// the pieces that are not covered yet
+		RectList pending;
+		pending.push_back(rect);
+
+		for(auto e = 0u; e < rects_.size() && !pending.empty(); ++e) {
+			for(auto p = 0u; p < pending.size();) {
+				if(!intersectsReal(rects_[e], pending[p])) {
+					++p;
+					continue;
+				}
+
+				Rect pieces[4];
+				auto count = detail::rectDifference(pending[p], rects_[e], pieces);
+				pending.erase(p);
+				for(auto i = 0u; i < count; ++i) {
+					if(!emptyRect(pieces[i])) {
+						pending.push_back(pieces[i]);
+					}
+				}
+			}
+		}
+
+		for(auto p = 0u; p < pending.size(); ++p) {
+			rects_.push_back(pending[p]);
+		}
+
+		normalize();
+	}
+
+	/// Removes the given rect from the region, in place.
+	/// Stored rects intersecting it are split using the difference()
+	/// logic; never allocates beyond the current storage.
+	void subtract(const Rect& rect) {
+		if(emptyRect(rect)) {
+			return;
+		}
+
+		for(auto i = 0u; i < rects_.size();) {
+			if(!intersectsReal(rects_[i], rect)) {
+				++i;
+				continue;
+			}
+
+			Rect pieces[4];
+			auto count = detail::rectDifference(rects_[i], rect, pieces);
+			rects_.erase(i);
+			for(auto n = 0u; n < count; ++n) {
+				if(!emptyRect(pieces[n])) {
+					rects_.push_back(pieces[n]);
+				}
+			}
+		}
+
+		normalize();
+	}
+
+	/// Intersects the region with the given rect, in place.
+	void intersect(const Rect& rect) {
+		for(auto i = 0u; i < rects_.size();) {
+			auto is = intersection(rects_[i], rect);
+			if(emptyRect(is)) {
+				rects_.erase(i);
+			} else {
+				rects_[i] = is;
+				++i;
+			}
+		}
+
+		normalize();
+	}
+
+	/// Returns whether the given point lies inside the region.
+	[[nodiscard]] bool contains(const Vec& point) const {
+		for(auto i = 0u; i < rects_.size(); ++i) {
+			if(nytl::contains(rects_[i], point)) {
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	/// Returns whether the given rect intersects the region.
+	[[nodiscard]] bool intersects(const Rect& rect) const {
+		for(auto i = 0u; i < rects_.size(); ++i) {
+			if(intersectsReal(rects_[i], rect)) {
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	/// Returns the bounding rect of the region.
+	[[nodiscard]] Rect bounds() const {
+		if(empty()) {
+			return {};
+		}
+
+		auto min = rects_[0].position;
+		auto max = rects_[0].position + rects_[0].size;
+		for(auto i = 1u; i < rects_.size(); ++i) {
+			min = vec::cw::min(min, rects_[i].position);
+			max = vec::cw::max(max, rects_[i].position + rects_[i].size);
+		}
+
+		return {min, max - min};
+	}
+
+	/// Returns the summed area of all stored rects.
+	[[nodiscard]] T area() const {
+		auto ret = T {0};
+		for(auto i = 0u; i < rects_.size(); ++i) {
+			ret += rects_[i].size[0] * rects_[i].size[1];
+		}
+
+		return ret;
+	}
+
+	/// The stored non-overlapping rects in band (y, then x) order.
+	[[nodiscard]] span<const Rect> rects() const {
+		return {rects_.data(), rects_.size()};
+	}
+
+	[[nodiscard]] std::size_t size() const { return rects_.size(); }
+	[[nodiscard]] bool empty() const { return rects_.empty(); }
+	void clear() { rects_.clear(); }
+
+protected:
+	static bool emptyRect(const Rect& r) {
+		return r.size[0] <= T {0} || r.size[1] <= T {0};
+	}
+
+	// Restores band order and merges horizontally adjacent rects
+	// of the same band.
+	void normalize() {
+		std::sort(rects_.data(), rects_.data() + rects_.size(),
+			[](const Rect& a, const Rect& b) {
+				return a.position.y < b.position.y ||
+					(a.position.y == b.position.y && a.position.x < b.position.x);
+			});
+
+		for(auto i = 1u; i < rects_.size();) {
+			auto& prev = rects_[i - 1];
+			auto& cur = rects_[i];
+			if(prev.position.y == cur.position.y &&
+					prev.size.y == cur.size.y &&
+					prev.position.x + prev.size.x == cur.position.x) {
+				prev.size.x += cur.size.x;
+				rects_.erase(i);
+			} else {
+				++i;
+			}
+		}
+	}
+
+	// Small-buffer rect storage: the first inlineCapacity rects live
+	// inside the region object, only larger regions spill to the heap.
+	class RectList {
+	public:
+		void push_back(const Rect& rect) {
+			if(!spilled_) {
+				if(size_ < inlineCapacity) {
+					inline_[size_++] = rect;
+					return;
+				}
+
+				// spill the inline rects to the heap
+				heap_.assign(inline_.data(), inline_.data() + size_);
+				spilled_ = true;
+			}
+
+			heap_.push_back(rect);
+			++size_;
+		}
+
+		void erase(std::size_t i) {
+			assert(i < size_);
+			auto ptr = data();
+			for(auto n = i + 1; n < size_; ++n) {
+				ptr[n - 1] = ptr[n];
+			}
+
+			--size_;
+			if(spilled_) {
+				heap_.pop_back();
+			}
+		}
+
+		void clear() {
+			size_ = 0;
+			spilled_ = false;
+			heap_.clear();
+		}
+
+		Rect* data() { return spilled_ ? heap_.data() : inline_.data(); }
+		const Rect* data() const { return spilled_ ? heap_.data() : inline_.data(); }
+		Rect& operator[](std::size_t i) { return data()[i]; }
+		const Rect& operator[](std::size_t i) const { return data()[i]; }
+		std::size_t size() const { return size_; }
+		bool empty() const { return size_ == 0; }
+
+	private:
+		std::array<Rect, inlineCapacity> inline_ {};
+		std::vector<Rect> heap_;
+		std::size_t size_ {};
+		bool spilled_ {};
+	};
+
+	RectList rects_;
+};
+
+using RegionF = Region<float>;
+using RegionI = Region<int>;
+using RegionU = Region<unsigned int>;
+
+} // namespace nytl
+
+#endif // header guard
@@ -0,0 +1,158 @@
+// Copyright (c) 2017-2020 nyorain
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt
+
+/// \file Lock-free single-producer single-consumer ring buffer.
+
+#pragma once
+
+#ifndef NYTL_INCLUDE_RING
+#define NYTL_INCLUDE_RING
+
+#include <nytl/span.hpp> // nytl::span
+#include <nytl/nonCopyable.hpp> // nytl::NonMovable
+
+#include <atomic> // std::atomic
+#include <memory> // std::allocator
+#include <utility> // std::move
+#include <cstddef> // std::size_t
+#include <cassert> // assert
+#include <algorithm> // std::min
+
+namespace nytl {
+
+/// \brief Fixed-capacity lock-free single-producer single-consumer queue.
+/// The canonical building block for handing values from one thread to
+/// another without locks or syscalls on the fast path, e.g. for feeding
+/// a (single-threaded) Callback on a render thread from audio or IO
+/// threads. Exactly one thread may push and exactly one thread may pop
+/// at any time; under that contract all operations are wait-free.
+/// The head and tail indices live on separate cache lines, each next
+/// to a local cache of the opposite index, so producer and consumer
+/// only touch each other's line when the cached value runs out.
+/// The capacity is rounded up to the next power of two.
+template<typename T>
+class RingBuffer : public NonMovable {
+public:
+	/// \param capacity The minimal number of elements the ring can
+	/// hold, must be > 0. Rounded up to the next power of two.
+	explicit RingBuffer(std::size_t capacity) {
+		assert(capacity > 0);
+		auto cap = std::size_t {1};
+		while(cap < capacity) {
+			cap <<= 1;
+		}
+
+		mask_ = cap - 1;
+		data_ = std::allocator<T>().allocate(cap);
+	}
+
+	~RingBuffer() {
+		auto head = head_.load();
+		auto tail = tail_.load();
+		for(; head != tail; ++head) {
+			data_[head & mask_].~T();
+		}
+
+		std::allocator<T>().deallocate(data_, mask_ + 1);
+	}
+
+	/// Tries to push the given value; producer thread only.
+	/// Returns false (leaving the ring unchanged) when the ring is full.
+	[[nodiscard]] bool tryPush(T value) {
+		auto tail = tail_.load(std::memory_order_relaxed);
+		if(tail - headCache_ > mask_) {
+			headCache_ = head_.load(std::memory_order_acquire);
+			if(tail - headCache_ > mask_) {
+				return false;
+			}
+		}
+
+		new(&data_[tail & mask_]) T(std::move(value));
+		tail_.store(tail + 1, std::memory_order_release);
+		return true;
+	}
+
+	/// Tries to pop a value into the given reference; consumer thread only.
+	/// Returns false (leaving the output unchanged) when the ring is empty.
+	[[nodiscard]] bool tryPop(T& value) {
+		auto head = head_.load(std::memory_order_relaxed);
+		if(head == tailCache_) {
+			tailCache_ = tail_.load(std::memory_order_acquire);
+			if(head == tailCache_) {
+				return false;
+			}
+		}
+
+		auto& slot = data_[head & mask_];
+		value = std::move(slot);
+		slot.~T();
+		head_.store(head + 1, std::memory_order_release);
+		return true;
+	}
+
+	/// Pushes as many of the given values as fit; producer thread only.
+	/// Returns the number of pushed values (a prefix of the span).
+	std::size_t push(span<const T> values) {
+		auto tail = tail_.load(std::memory_order_relaxed);
+		auto free = mask_ + 1 - (tail - headCache_);
+		if(free < values.size()) {
+			headCache_ = head_.load(std::memory_order_acquire);
+			free = mask_ + 1 - (tail - headCache_);
+		}
+
+		auto count = std::min(free, values.size());
+		for(auto i = std::size_t {0}; i < count; ++i) {
+			new(&data_[(tail + i) & mask_]) T(values[i]);
+		}
+
+		tail_.store(tail + count, std::memory_order_release);
+		return count;
+	}
+
+	/// Pops up to values.size() values into the given span; consumer
+	/// thread only. Returns the number of popped values.
+	std::size_t pop(span<T> values) {
+		auto head = head_.load(std::memory_order_relaxed);
+		auto avail = tailCache_ - head;
+		if(avail < values.size()) {
+			tailCache_ = tail_.load(std::memory_order_acquire);
+			avail = tailCache_ - head;
+		}
+
+		auto count = std::min(avail, values.size());
+		for(auto i = std::size_t {0}; i < count; ++i) {
+			auto& slot = data_[(head + i) & mask_];
+			values[i] = std::move(slot);
+			slot.~T();
+		}
+
+		head_.store(head + count, std::memory_order_release);
+		return count;
+	}
+
+	/// The number of values currently in the ring.
+	/// Only an instantaneous approximation unless called from the
+	/// producer (lower bound exact) or consumer (upper bound exact).
+	[[nodiscard]] std::size_t size() const {
+		return tail_.load(std::memory_order_acquire)
+			- head_.load(std::memory_order_acquire);
+	}
+
+	[[nodiscard]] bool empty() const { return size() == 0; }
+	[[nodiscard]] std::size_t capacity() const { return mask_ + 1; }
+
+private:
+	// both indices grow monotonically and are masked on access
+	static constexpr std::size_t cacheLine = 64;
+	alignas(cacheLine) std::atomic<std::size_t> head_ {}; // consumer side
+	std::size_t tailCache_ {}; // consumer's view of tail_
+	alignas(cacheLine) std::atomic<std::size_t> tail_ {}; // producer side
+	std::size_t headCache_ {}; // producer's view of head_
+	alignas(cacheLine) T* data_ {};
+	std::size_t mask_ {};
+};
+
+} // namespace nytl
+
+#endif // header guard
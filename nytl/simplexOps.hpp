@@ -0,0 +1,335 @@
+// Copyright (c) 2017-2020 nyorain
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt
+
+/// \file Various simplex related operations, mainly barycentric coordinates.
+
+#pragma once
+
+#ifndef NYTL_INCLUDE_SIMPLEX_OPS
+#define NYTL_INCLUDE_SIMPLEX_OPS
+
+#include <nytl/simplex.hpp> // nytl::Simplex
+#include <nytl/vecOps.hpp> // nytl::cross
+#include <nytl/matOps.hpp> // nytl::luDecomp
+#include <nytl/span.hpp> // nytl::span
+
+#include <cstdint> // std::uint64_t
+#include <cassert> // assert
+
+namespace nytl {
+
+/// \brief Returns the barycentric coordinates of the given point.
+/// Generic fallback for simplexes that fill their space (D == A):
+/// solves the linear system through the LU machinery from matOps.
+/// The specialized triangle and tetrahedron overloads below are
+/// closed-form and much cheaper, they take over for D <= 3.
+/// \module simplex
+template<std::size_t D, typename P, typename = std::enable_if_t<(D > 3)>>
+Vec<D + 1, double> barycentric(const Simplex<D, P, D>& simplex, const Vec<D, P>& point) {
+	// one row per space coordinate plus the partition-of-unity row
+	Mat<D + 1, D + 1, double> m;
+	Vec<D + 1, double> b;
+	for(auto d = 0u; d < D; ++d) {
+		for(auto i = 0u; i < D + 1; ++i) {
+			m[d][i] = simplex.points()[i][d];
+		}
+
+		b[d] = point[d];
+	}
+
+	for(auto i = 0u; i < D + 1; ++i) {
+		m[D][i] = 1.0;
+	}
+
+	b[D] = 1.0;
+	return luEvaluate(luDecomp(m), b);
+}
+
+/// \brief Closed-form barycentric coordinates for a triangle.
+/// Works in any space dimension; for D > 2 the point is implicitly
+/// projected onto the triangle plane.
+/// \module simplex
+template<std::size_t D, typename P>
+constexpr Vec<3, double> barycentric(const Simplex<D, P, 2>& tri, const Vec<D, P>& point) {
+	auto v0 = Vec<D, double>(tri.points()[1] - tri.points()[0]);
+	auto v1 = Vec<D, double>(tri.points()[2] - tri.points()[0]);
+	auto v2 = Vec<D, double>(point - tri.points()[0]);
+
+	auto d00 = dot(v0, v0);
+	auto d01 = dot(v0, v1);
+	auto d11 = dot(v1, v1);
+	auto d20 = dot(v2, v0);
+	auto d21 = dot(v2, v1);
+
+	auto denom = d00 * d11 - d01 * d01;
+	auto v = (d11 * d20 - d01 * d21) / denom;
+	auto w = (d00 * d21 - d01 * d20) / denom;
+	return {1.0 - v - w, v, w};
+}
+
+/// \brief Closed-form barycentric coordinates for a tetrahedron,
+/// using scalar triple products instead of a linear solve.
+/// \module simplex
+template<typename P>
+constexpr Vec<4, double> barycentric(const Simplex<3, P, 3>& tet, const Vec<3, P>& point) {
+	auto v = Vec<3, double>(tet.points()[1] - tet.points()[0]);
+	auto w = Vec<3, double>(tet.points()[2] - tet.points()[0]);
+	auto u = Vec<3, double>(tet.points()[3] - tet.points()[0]);
+	auto q = Vec<3, double>(point - tet.points()[0]);
+
+	// det(v, w, u) under cyclic rotation
+	auto denom = dot(cross(v, w), u);
+	auto l1 = dot(cross(w, u), q) / denom;
+	auto l2 = dot(cross(u, v), q) / denom;
+	auto l3 = dot(cross(v, w), q) / denom;
+	return {1.0 - l1 - l2 - l3, l1, l2, l3};
+}
+
+/// \brief Returns whether the simplex contains the given point.
+/// Points on the boundary count as contained.
+/// \module simplex
+template<std::size_t D, typename P, std::size_t A>
+constexpr bool contains(const Simplex<D, P, A>& simplex, const Vec<D, P>& point) {
+	auto bary = barycentric(simplex, point);
+	for(auto i = 0u; i < A + 1; ++i) {
+		if(bary[i] < 0.0) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/// \brief Batch point-in-triangle test, writes one bit per point.
+/// Bit i of the mask is set iff the triangle contains points[i],
+/// boundary points count. The mask must hold at least
+/// points.size() bits, i.e. (points.size() + 63) / 64 entries.
+/// Branchless edge-function form, the inner loop vectorizes.
+/// \module simplex
+template<typename P1, typename P2>
+void containsMask(const Simplex<2, P1, 2>& tri, span<const Vec<2, P2>> points,
+		span<std::uint64_t> mask) {
+	assert(mask.size() >= (points.size() + 63) / 64);
+	for(auto i = 0u; i < mask.size(); ++i) {
+		mask[i] = 0u;
+	}
+
+	auto a = tri.points()[0];
+	auto b = tri.points()[1];
+	auto c = tri.points()[2];
+
+	// signed doubled area; flips the edge functions for clockwise
+	// triangles so the test is winding-independent
+	auto area = double(cross(b - a, c - a));
+
+	for(auto i = std::size_t {0}; i < points.size(); ++i) {
+		auto p = points[i];
+		auto e0 = double(cross(b - a, p - a));
+		auto e1 = double(cross(c - b, p - b));
+		auto e2 = double(cross(a - c, p - c));
+
+		auto hit = std::uint64_t(
+			(e0 * area >= 0.0) & (e1 * area >= 0.0) & (e2 * area >= 0.0));
+		mask[i >> 6] |= hit << (i & 63);
+	}
+}
+
+namespace detail {
+
+/// Closest point on triangle (a, b, c) to p, Ericson's voronoi-region
+/// walk: at most two dot products per rejected region, no normalization
+/// and no divisions until the containing region is known.
+template<std::size_t D>
+constexpr Vec<D, double> closestPointTri(const Vec<D, double>& a,
+		const Vec<D, double>& b, const Vec<D, double>& c,
+		const Vec<D, double>& p) {
+	auto ab = b - a;
+	auto ac = c - a;
+	auto ap = p - a;
+
+	auto d1 = dot(ab, ap);
+	auto d2 = dot(ac, ap);
+	if(d1 <= 0.0 && d2 <= 0.0) {
+		return a; // vertex region a
+	}
+
+	auto bp = p - b;
+	auto d3 = dot(ab, bp);
+	auto d4 = dot(ac, bp);
+	if(d3 >= 0.0 && d4 <= d3) {
+		return b; // vertex region b
+	}
+
+	auto vc = d1 * d4 - d3 * d2;
+	if(vc <= 0.0 && d1 >= 0.0 && d3 <= 0.0) {
+		return a + (d1 / (d1 - d3)) * ab; // edge region ab
+	}
+
+	auto cp = p - c;
+	auto d5 = dot(ab, cp);
+	auto d6 = dot(ac, cp);
+	if(d6 >= 0.0 && d5 <= d6) {
+		return c; // vertex region c
+	}
+
+	auto vb = d5 * d2 - d1 * d6;
+	if(vb <= 0.0 && d2 >= 0.0 && d6 <= 0.0) {
+		return a + (d2 / (d2 - d6)) * ac; // edge region ac
+	}
+
+	auto va = d3 * d6 - d5 * d4;
+	if(va <= 0.0 && d4 - d3 >= 0.0 && d5 - d6 >= 0.0) {
+		return b + ((d4 - d3) / ((d4 - d3) + (d5 - d6))) * (c - b); // edge bc
+	}
+
+	// face region
+	auto denom = 1.0 / (va + vb + vc);
+	return a + (vb * denom) * ab + (vc * denom) * ac;
+}
+
+} // namespace detail
+
+/// \brief Returns the closest point on the given line segment to the
+/// given point, i.e. the projection onto the segment clamped to it.
+/// \module simplex
+template<std::size_t D, typename P>
+constexpr Vec<D, double> closestPoint(const Simplex<D, P, 1>& line,
+		const Vec<D, P>& point) {
+	auto a = Vec<D, double>(line.points()[0]);
+	auto ab = Vec<D, double>(line.points()[1]) - a;
+	auto t = dot(Vec<D, double>(point) - a, ab) / dot(ab, ab);
+	t = t < 0.0 ? 0.0 : t > 1.0 ? 1.0 : t;
+	return a + t * ab;
+}
+
+/// \brief Returns the closest point on (or in) the given triangle to
+/// the given point. Works in any space dimension.
+/// \module simplex
+template<std::size_t D, typename P>
+constexpr Vec<D, double> closestPoint(const Simplex<D, P, 2>& tri,
+		const Vec<D, P>& point) {
+	return detail::closestPointTri(
+		Vec<D, double>(tri.points()[0]), Vec<D, double>(tri.points()[1]),
+		Vec<D, double>(tri.points()[2]), Vec<D, double>(point));
+}
+
+/// \brief Returns the closest point on (or in) the given tetrahedron
+/// to the given point. Points inside are returned unchanged, outside
+/// points are projected onto the closest face.
+/// \module simplex
+template<typename P>
+Vec<3, double> closestPoint(const Simplex<3, P, 3>& tet, const Vec<3, P>& point) {
+	auto a = Vec<3, double>(tet.points()[0]);
+	auto b = Vec<3, double>(tet.points()[1]);
+	auto c = Vec<3, double>(tet.points()[2]);
+	auto d = Vec<3, double>(tet.points()[3]);
+	auto p = Vec<3, double>(point);
+
+	// only faces whose outward halfspace contains p can hold the
+	// closest point; if no face does, p is inside
+	struct Face { Vec<3, double> a, b, c, opposite; };
+	const Face faces[4] = {
+		{a, b, c, d}, {a, c, d, b}, {a, d, b, c}, {b, d, c, a}};
+
+	auto best = p;
+	auto bestSq = -1.0;
+	for(auto& f : faces) {
+		auto n = cross(f.b - f.a, f.c - f.a);
+		auto side = dot(p - f.a, n);
+		auto ref = dot(f.opposite - f.a, n);
+		if(side * ref >= 0.0) {
+			continue; // p on the inner side of this face
+		}
+
+		auto q = detail::closestPointTri(f.a, f.b, f.c, p);
+		auto distSq = dot(q - p, q - p);
+		if(bestSq < 0.0 || distSq < bestSq) {
+			bestSq = distSq;
+			best = q;
+		}
+	}
+
+	return best;
+}
+
+/// \brief Returns the squared distance of the given point to the given
+/// simplex, zero for contained points.
+/// \module simplex
+template<std::size_t D, typename P, std::size_t A>
+constexpr double distanceSq(const Simplex<D, P, A>& simplex, const Vec<D, P>& point) {
+	auto diff = closestPoint(simplex, point) - Vec<D, double>(point);
+	return dot(diff, diff);
+}
+
+/// \brief Batch closest-point-on-triangle query.
+/// Writes the closest point to points[i] into out[i]; the spans must
+/// have the same size. The triangle edges are hoisted out of the loop,
+/// per point only the voronoi-region walk remains.
+/// \module simplex
+template<std::size_t D, typename P1, typename P2>
+void closestPoints(const Simplex<D, P1, 2>& tri, span<const Vec<D, P2>> points,
+		span<Vec<D, double>> out) {
+	assert(out.size() >= points.size());
+	auto a = Vec<D, double>(tri.points()[0]);
+	auto b = Vec<D, double>(tri.points()[1]);
+	auto c = Vec<D, double>(tri.points()[2]);
+	for(auto i = std::size_t {0}; i < points.size(); ++i) {
+		out[i] = detail::closestPointTri(a, b, c, Vec<D, double>(points[i]));
+	}
+}
+
+/// \brief Batch closest-point-on-tetrahedron query.
+/// Precomputes the four face planes once, so contained points (the
+/// common case in collision queries) cost only four dot products each;
+/// only points outside a face run the per-face triangle walk.
+/// \module simplex
+template<typename P1, typename P2>
+void closestPoints(const Simplex<3, P1, 3>& tet, span<const Vec<3, P2>> points,
+		span<Vec<3, double>> out) {
+	assert(out.size() >= points.size());
+	auto a = Vec<3, double>(tet.points()[0]);
+	auto b = Vec<3, double>(tet.points()[1]);
+	auto c = Vec<3, double>(tet.points()[2]);
+	auto d = Vec<3, double>(tet.points()[3]);
+
+	// outward-oriented face planes: dot(n, x) > off means outside
+	struct Face { Vec<3, double> a, b, c, n; double off; };
+	Face faces[4] = {
+		{a, b, c, {}, 0.0}, {a, c, d, {}, 0.0},
+		{a, d, b, {}, 0.0}, {b, d, c, {}, 0.0}};
+	const Vec<3, double> opposite[4] = {d, b, c, a};
+	for(auto i = 0u; i < 4; ++i) {
+		auto& f = faces[i];
+		f.n = cross(f.b - f.a, f.c - f.a);
+		if(dot(opposite[i] - f.a, f.n) > 0.0) {
+			f.n = -f.n;
+		}
+
+		f.off = dot(f.a, f.n);
+	}
+
+	for(auto i = std::size_t {0}; i < points.size(); ++i) {
+		auto p = Vec<3, double>(points[i]);
+		auto best = p;
+		auto bestSq = -1.0;
+		for(auto& f : faces) {
+			if(dot(p, f.n) <= f.off) {
+				continue; // inner side of this face
+			}
+
+			auto q = detail::closestPointTri(f.a, f.b, f.c, p);
+			auto distSq = dot(q - p, q - p);
+			if(bestSq < 0.0 || distSq < bestSq) {
+				bestSq = distSq;
+				best = q;
+			}
+		}
+
+		out[i] = best;
+	}
+}
+
+} // namespace nytl
+
+#endif // header guard
@@ -0,0 +1,131 @@
+// Copyright (c) 2017-2020 nyorain
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt
+
+/// \file Defines the StaticCallback template class.
+
+#pragma once
+
+#ifndef NYTL_INCLUDE_STATIC_CALLBACK
+#define NYTL_INCLUDE_STATIC_CALLBACK
+
+#include <nytl/functionTraits.hpp> // nytl::FunctionTraits
+
+#include <tuple> // std::tuple
+#include <bitset> // std::bitset
+#include <utility> // std::index_sequence
+#include <cstdlib> // std::size_t
+
+namespace nytl {
+
+/// Callback over a listener set fixed at compile time.
+/// Unlike nytl::Callback there is no type erasure: the listeners are
+/// stored by value in a tuple and emission expands to a sequence of
+/// direct (inlinable) calls via fold expression. Listeners cannot be
+/// added or removed at runtime, but each one can be enabled and
+/// disabled through a bitset, with a Connection-style handle whose
+/// disconnect() disables its listener.
+/// The first listener defines the callback signature (through
+/// FunctionTraits); all listeners must be callable with it.
+template<typename... Listeners>
+class StaticCallback {
+public:
+	static_assert(sizeof...(Listeners) > 0);
+	static constexpr std::size_t listenerCount = sizeof...(Listeners);
+
+	using First = std::tuple_element_t<0, std::tuple<Listeners...>>;
+	using Signature = typename FunctionTraits<First>::Signature;
+
+	/// Disables its associated listener on disconnect.
+	/// Mirrors the interface of ConnectionT, without an id.
+	class Connection {
+	public:
+		Connection() noexcept = default;
+		Connection(StaticCallback& callback, std::size_t listener)
+			: callback_(&callback), listener_(listener) {}
+
+		void disconnect() {
+			if(callback_) {
+				callback_->disable(listener_);
+			}
+
+			callback_ = {};
+		}
+
+		bool connected() const noexcept {
+			return callback_ && callback_->enabled(listener_);
+		}
+
+		StaticCallback* connectable() const { return callback_; }
+
+	protected:
+		StaticCallback* callback_ {};
+		std::size_t listener_ {};
+	};
+
+public:
+	StaticCallback() { enabled_.set(); }
+	StaticCallback(Listeners... listeners)
+			: listeners_(std::move(listeners)...) {
+		enabled_.set();
+	}
+
+	/// Calls all enabled listeners in declaration order.
+	/// The arguments are passed to every listener.
+	template<typename... Args>
+	void call(Args&&... args) {
+		callAll(std::index_sequence_for<Listeners...> {}, args...);
+	}
+
+	/// Operator version of call.
+	template<typename... Args>
+	void operator()(Args&&... args) {
+		call(std::forward<Args>(args)...);
+	}
+
+	/// Enables/disables the listener with the given index.
+	template<std::size_t I> void enable() { enabled_.set(I); }
+	template<std::size_t I> void disable() { enabled_.reset(I); }
+	void enable(std::size_t i) { enabled_.set(i); }
+	void disable(std::size_t i) { enabled_.reset(i); }
+
+	bool enabled(std::size_t i) const { return enabled_.test(i); }
+
+	/// Returns a connection handle for the listener with the given
+	/// index, disconnecting it disables the listener.
+	template<std::size_t I>
+	Connection connection() {
+		static_assert(I < listenerCount);
+		return {*this, I};
+	}
+
+	/// Direct access to the listener with the given index.
+	template<std::size_t I>
+	auto& listener() {
+		return std::get<I>(listeners_);
+	}
+
+protected:
+	template<std::size_t... Is, typename... Args>
+	void callAll(std::index_sequence<Is...>, Args&... args) {
+		(callOne<Is>(args...), ...);
+	}
+
+	template<std::size_t I, typename... Args>
+	void callOne(Args&... args) {
+		if(enabled_[I]) {
+			std::get<I>(listeners_)(args...);
+		}
+	}
+
+	std::tuple<Listeners...> listeners_;
+	std::bitset<listenerCount> enabled_;
+};
+
+/// Deduces the listener types from the constructor arguments.
+template<typename... Listeners>
+StaticCallback(Listeners...) -> StaticCallback<Listeners...>;
+
+} // namespace nytl
+
+#endif // header guard
@@ -0,0 +1,172 @@
+// Copyright (c) 2017-2020 nyorain
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt
+
+/// \file Defines the StaticVector template class.
+
+#pragma once
+
+#ifndef NYTL_INCLUDE_STATIC_VECTOR
+#define NYTL_INCLUDE_STATIC_VECTOR
+
+#include <type_traits> // std::is_trivially_destructible
+#include <utility> // std::move
+#include <new> // placement new
+#include <cstddef> // std::byte
+#include <cstdlib> // std::size_t
+#include <cassert> // assert
+
+namespace nytl {
+
+/// A vector with fixed inline capacity that never allocates.
+/// Intended for small result sets with a compile-time bound, e.g.
+/// the pieces of a rect difference. The interface is the relevant
+/// subset of std::vector, so it converts to nytl::span and works
+/// with range-based for. Exceeding the capacity is a programming
+/// error (checked by assert), not a growth trigger.
+template<typename T, std::size_t N>
+class StaticVector {
+public:
+	using value_type = T;
+	using iterator = T*;
+	using const_iterator = const T*;
+
+public:
+	StaticVector() = default;
+	explicit StaticVector(std::size_t count, const T& value = T {}) {
+		assert(count <= N);
+		for(auto i = std::size_t {0}; i < count; ++i) {
+			push_back(value);
+		}
+	}
+
+	StaticVector(const StaticVector& rhs) {
+		for(auto& val : rhs) {
+			push_back(val);
+		}
+	}
+
+	StaticVector(StaticVector&& rhs) noexcept(std::is_nothrow_move_constructible_v<T>) {
+		for(auto& val : rhs) {
+			push_back(std::move(val));
+		}
+
+		rhs.clear();
+	}
+
+	StaticVector& operator=(const StaticVector& rhs) {
+		clear();
+		for(auto& val : rhs) {
+			push_back(val);
+		}
+
+		return *this;
+	}
+
+	StaticVector& operator=(StaticVector&& rhs) noexcept(std::is_nothrow_move_constructible_v<T>) {
+		clear();
+		for(auto& val : rhs) {
+			push_back(std::move(val));
+		}
+
+		rhs.clear();
+		return *this;
+	}
+
+	~StaticVector() {
+		clear();
+	}
+
+	void push_back(const T& value) {
+		assert(size_ < N);
+		new(data() + size_) T(value);
+		++size_;
+	}
+
+	void push_back(T&& value) {
+		assert(size_ < N);
+		new(data() + size_) T(std::move(value));
+		++size_;
+	}
+
+	template<typename... Args>
+	T& emplace_back(Args&&... args) {
+		assert(size_ < N);
+		auto ptr = new(data() + size_) T(std::forward<Args>(args)...);
+		++size_;
+		return *ptr;
+	}
+
+	void pop_back() {
+		assert(size_ > 0);
+		--size_;
+		if constexpr(!std::is_trivially_destructible_v<T>) {
+			data()[size_].~T();
+		}
+	}
+
+	void clear() {
+		if constexpr(!std::is_trivially_destructible_v<T>) {
+			for(auto i = size_; i > 0; --i) {
+				data()[i - 1].~T();
+			}
+		}
+
+		size_ = 0;
+	}
+
+	T& operator[](std::size_t i) { assert(i < size_); return data()[i]; }
+	const T& operator[](std::size_t i) const { assert(i < size_); return data()[i]; }
+	T& front() { assert(size_ > 0); return data()[0]; }
+	const T& front() const { assert(size_ > 0); return data()[0]; }
+	T& back() { assert(size_ > 0); return data()[size_ - 1]; }
+	const T& back() const { assert(size_ > 0); return data()[size_ - 1]; }
+
+	// casting through void keeps -Wcast-align=strict quiet, the
+	// storage is alignas(T) anyways
+	T* data() {
+		return std::launder(static_cast<T*>(static_cast<void*>(storage_)));
+	}
+	const T* data() const {
+		return std::launder(static_cast<const T*>(
+			static_cast<const void*>(storage_)));
+	}
+
+	iterator begin() { return data(); }
+	iterator end() { return data() + size_; }
+	const_iterator begin() const { return data(); }
+	const_iterator end() const { return data() + size_; }
+
+	std::size_t size() const { return size_; }
+	bool empty() const { return size_ == 0; }
+	static constexpr std::size_t capacity() { return N; }
+	static constexpr std::size_t max_size() { return N; }
+
+protected:
+	alignas(T) std::byte storage_[N * sizeof(T)];
+	std::size_t size_ {};
+};
+
+template<typename T, std::size_t N>
+bool operator==(const StaticVector<T, N>& a, const StaticVector<T, N>& b) {
+	if(a.size() != b.size()) {
+		return false;
+	}
+
+	for(auto i = std::size_t {0}; i < a.size(); ++i) {
+		if(!(a[i] == b[i])) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+template<typename T, std::size_t N>
+bool operator!=(const StaticVector<T, N>& a, const StaticVector<T, N>& b) {
+	return !(a == b);
+}
+
+} // namespace nytl
+
+#endif // header guard
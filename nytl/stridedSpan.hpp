@@ -0,0 +1,276 @@
+// Copyright (c) 2017-2020 nyorain
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt
+
+/// \file Non-contiguous span variants: strided and 2D views.
+
+#pragma once
+
+#ifndef NYTL_INCLUDE_STRIDED_SPAN
+#define NYTL_INCLUDE_STRIDED_SPAN
+
+#include <nytl/span.hpp> // nytl::span
+#include <nytl/bytes.hpp> // nytl::bytes
+#include <nytl/vecBatchOps.hpp> // nytl::VecSoA
+
+#include <cassert> // assert
+#include <cstddef> // std::byte
+#include <type_traits> // std::is_const_v
+
+namespace nytl {
+
+/// Signals that the stride of a StridedSpan is only known at runtime.
+constexpr auto dynamicStride = std::size_t(-1);
+
+namespace detail {
+
+template<std::size_t Stride>
+struct StrideHolder {
+	constexpr StrideHolder() = default;
+	constexpr StrideHolder(std::size_t stride) { assert(stride == Stride); }
+	constexpr std::size_t stride() const { return Stride; }
+};
+
+template<>
+struct StrideHolder<dynamicStride> {
+	constexpr StrideHolder() = default;
+	constexpr StrideHolder(std::size_t stride) : stride_(stride) {}
+	constexpr std::size_t stride() const { return stride_; }
+	std::size_t stride_ {};
+};
+
+// Byte-to-element cast through void, the callers guarantee the
+// pointer is suitably aligned for T (a direct reinterpret_cast from
+// std::byte* trips -Wcast-align=strict).
+template<typename T, typename Byte>
+T* alignedCast(Byte* ptr) {
+	using Void = std::conditional_t<std::is_const_v<Byte>,
+		const void, void>;
+	return static_cast<T*>(static_cast<Void*>(ptr));
+}
+
+} // namespace detail
+
+/// \brief View on elements of type T placed a fixed number of bytes apart.
+/// Useful to address one attribute inside an interleaved buffer (e.g. the
+/// positions in a vertex buffer with 32 byte stride) without deinterleaving
+/// it first. Like span it never owns the memory it references.
+/// The stride is given in bytes and may be known at compile time via the
+/// template parameter; the default keeps it a runtime value. A stride
+/// smaller than sizeof(T) is invalid except for a zero stride, which
+/// makes the view broadcast a single element.
+template<typename T, std::size_t Stride = dynamicStride>
+class StridedSpan : public detail::StrideHolder<Stride> {
+public:
+	using Byte = std::conditional_t<std::is_const_v<T>,
+		const std::byte, std::byte>;
+
+	class Iterator {
+	public:
+		Iterator(Byte* data, std::size_t stride) :
+			data_(data), stride_(stride) {}
+
+		T& operator*() const { return *detail::alignedCast<T>(data_); }
+		Iterator& operator++() { data_ += stride_; return *this; }
+		bool operator==(const Iterator& o) const { return data_ == o.data_; }
+		bool operator!=(const Iterator& o) const { return data_ != o.data_; }
+
+	protected:
+		Byte* data_;
+		std::size_t stride_;
+	};
+
+public:
+	StridedSpan() = default;
+
+	/// Constructs the view from a typed pointer to the first element.
+	/// For a dynamic stride defaulting the stride makes this a plain
+	/// contiguous view.
+	StridedSpan(T* data, std::size_t size, std::size_t stride = sizeof(T)) :
+			detail::StrideHolder<Stride>(stride),
+			data_(reinterpret_cast<Byte*>(data)), size_(size) {
+		assert(this->stride() >= sizeof(T) || this->stride() == 0);
+	}
+
+	/// Constructs the view from raw buffer memory, as obtained e.g.
+	/// from a mapped GPU staging allocation.
+	StridedSpan(Byte* data, std::size_t size, std::size_t stride) :
+			detail::StrideHolder<Stride>(stride),
+			data_(data), size_(size) {
+		assert(this->stride() >= sizeof(T) || this->stride() == 0);
+	}
+
+	/// A contiguous span is just the stride == sizeof(T) special case.
+	StridedSpan(span<T> contiguous) :
+		detail::StrideHolder<Stride>(sizeof(T)),
+		data_(reinterpret_cast<Byte*>(contiguous.data())),
+		size_(contiguous.size()) {}
+
+	/// Conversions that only add const or drop a compile-time stride.
+	template<typename U, std::size_t US, typename = std::enable_if_t<
+		std::is_convertible_v<U(*)[], T(*)[]>>>
+	StridedSpan(const StridedSpan<U, US>& other) :
+		detail::StrideHolder<Stride>(other.stride()),
+		data_(other.data()), size_(other.size()) {}
+
+	T& operator[](std::size_t i) const {
+		assert(i < size_);
+		return *detail::alignedCast<T>(data_ + i * this->stride());
+	}
+
+	[[nodiscard]] Byte* data() const { return data_; }
+	[[nodiscard]] std::size_t size() const { return size_; }
+	[[nodiscard]] bool empty() const { return size_ == 0; }
+	[[nodiscard]] bool contiguous() const {
+		return this->stride() == sizeof(T);
+	}
+
+	Iterator begin() const { return {data_, this->stride()}; }
+	Iterator end() const { return {data_ + size_ * this->stride(),
+		this->stride()}; }
+
+	StridedSpan subspan(std::size_t offset,
+			std::size_t count = dynamicStride) const {
+		assert(offset <= size_);
+		if(count == dynamicStride) {
+			count = size_ - offset;
+		}
+
+		assert(offset + count <= size_);
+		return {data_ + offset * this->stride(), count, this->stride()};
+	}
+
+	/// Only valid when the view is contiguous().
+	span<T> contiguousSpan() const {
+		assert(contiguous());
+		return {detail::alignedCast<T>(data_), size_};
+	}
+
+protected:
+	Byte* data_ {};
+	std::size_t size_ {};
+};
+
+/// \brief View on a 2D array of T with a row pitch in bytes.
+/// Rows themselves are contiguous, consecutive rows start pitch bytes
+/// apart; the usual layout of image and staging memory where rows are
+/// padded for alignment. Addressed as (x, y) with y selecting the row.
+template<typename T>
+class Span2D {
+public:
+	using Byte = typename StridedSpan<T>::Byte;
+
+public:
+	Span2D() = default;
+	Span2D(T* data, std::size_t width, std::size_t height,
+			std::size_t pitch = 0) :
+			data_(reinterpret_cast<Byte*>(data)), width_(width),
+			height_(height), pitch_(pitch ? pitch : width * sizeof(T)) {
+		assert(pitch_ >= width_ * sizeof(T));
+	}
+
+	Span2D(Byte* data, std::size_t width, std::size_t height,
+			std::size_t pitch) :
+			data_(data), width_(width), height_(height), pitch_(pitch) {
+		assert(pitch_ >= width_ * sizeof(T));
+	}
+
+	T& operator()(std::size_t x, std::size_t y) const {
+		assert(x < width_ && y < height_);
+		return detail::alignedCast<T>(data_ + y * pitch_)[x];
+	}
+
+	span<T> row(std::size_t y) const {
+		assert(y < height_);
+		return {detail::alignedCast<T>(data_ + y * pitch_), width_};
+	}
+
+	/// Returns a strided view on one column.
+	StridedSpan<T> column(std::size_t x) const {
+		assert(x < width_);
+		return {data_ + x * sizeof(T), height_, pitch_};
+	}
+
+	/// Returns a view on the given sub-rectangle, sharing the memory.
+	Span2D sub(std::size_t x, std::size_t y, std::size_t width,
+			std::size_t height) const {
+		assert(x + width <= width_ && y + height <= height_);
+		return {data_ + y * pitch_ + x * sizeof(T), width, height, pitch_};
+	}
+
+	[[nodiscard]] std::size_t width() const { return width_; }
+	[[nodiscard]] std::size_t height() const { return height_; }
+	[[nodiscard]] std::size_t pitch() const { return pitch_; }
+	[[nodiscard]] bool empty() const { return width_ == 0 || height_ == 0; }
+
+protected:
+	Byte* data_ {};
+	std::size_t width_ {};
+	std::size_t height_ {};
+	std::size_t pitch_ {};
+};
+
+// - bytes.hpp interop -
+/// Serializes all elements of the strided view, packed (without the
+/// stride padding), through the usual bytes() machinery.
+template<typename T, std::size_t Stride>
+void write(WriteBuf& buf, StridedSpan<T, Stride> src) {
+	if(src.contiguous()) {
+		write(buf, ReadBuf(bytes(src.contiguousSpan())));
+		return;
+	}
+
+	for(const auto& val : src) {
+		write(buf, ReadBuf(bytes(val)));
+	}
+}
+
+template<typename T, std::size_t Stride>
+void write(DynWriteBuf& buf, StridedSpan<T, Stride> src) {
+	if(src.contiguous()) {
+		write(buf, ReadBuf(bytes(src.contiguousSpan())));
+		return;
+	}
+
+	for(const auto& val : src) {
+		write(buf, ReadBuf(bytes(val)));
+	}
+}
+
+/// Deserializes packed elements into the strided view.
+template<typename T, std::size_t Stride>
+void read(ReadBuf& buf, StridedSpan<T, Stride> dst) {
+	static_assert(!std::is_const_v<T>);
+	if(dst.contiguous()) {
+		read(buf, bytes(dst.contiguousSpan()));
+		return;
+	}
+
+	for(auto& val : dst) {
+		read(buf, bytes(val));
+	}
+}
+
+// - vecBatchOps interop -
+/// Gathers the vectors of an interleaved attribute into SoA storage
+/// so the batch kernels from vecBatchOps.hpp can run over them.
+template<typename V, std::size_t Stride, size_t D, typename T>
+void gather(StridedSpan<V, Stride> src, VecSoA<D, T>& dst) {
+	dst.resize(src.size());
+	for(auto i = 0u; i < src.size(); ++i) {
+		dst.set(i, src[i]);
+	}
+}
+
+/// Scatters SoA storage back into an interleaved attribute view.
+template<size_t D, typename T, std::size_t Stride>
+void scatter(const VecSoA<D, T>& src, StridedSpan<Vec<D, T>, Stride> dst) {
+	assert(src.size() == dst.size());
+	for(auto i = 0u; i < dst.size(); ++i) {
+		dst[i] = src[i];
+	}
+}
+
+} // namespace nytl
+
+#endif // header guard
@@ -9,6 +9,8 @@
 
 #include <string_view>
 #include <string>
+#include <cstdint> // std::uint64_t
+#include <type_traits> // std::make_unsigned
 
 namespace nytl {
 
@@ -33,6 +35,74 @@ using StringParam = BasicStringParam<char>;
 using StringParam32 = BasicStringParam<char32_t>;
 using StringParam16 = BasicStringParam<char16_t>;
 
+/// Constexpr FNV-1a hash of the given string.
+/// For string literals the hash folds at the call site already.
+template<typename Char>
+constexpr std::uint64_t fnv1a(std::basic_string_view<Char> view) {
+	auto hash = std::uint64_t(0xcbf29ce484222325);
+	for(auto c : view) {
+		hash ^= std::uint64_t(std::make_unsigned_t<Char>(c));
+		hash *= 0x100000001b3;
+	}
+
+	return hash;
+}
+
+/// A StringParam that additionally carries the FNV-1a hash of its
+/// contents, computed once on construction (at compile time for
+/// literals). Comparisons check the hashes first and only fall back
+/// to a real string comparison when they match, and unordered
+/// containers keyed on it reuse the stored hash instead of rehashing
+/// on every lookup. Meant for name-based parameter/uniform lookup
+/// where the same few strings are looked up many times.
+template<typename Char>
+class BasicHashedStringParam : public BasicStringParam<Char> {
+public:
+	using typename BasicStringParam<Char>::string_view;
+	using typename BasicStringParam<Char>::string;
+
+public:
+	constexpr BasicHashedStringParam() = default;
+	constexpr BasicHashedStringParam(const Char* cstr) :
+		BasicStringParam<Char>(cstr), hash_(fnv1a<Char>(*this)) {}
+	BasicHashedStringParam(const string& str) :
+		BasicStringParam<Char>(str), hash_(fnv1a<Char>(*this)) {}
+
+	[[nodiscard]] constexpr std::uint64_t hash() const { return hash_; }
+
+protected:
+	std::uint64_t hash_ {fnv1a<Char>(string_view {})};
+};
+
+template<typename Char>
+constexpr bool operator==(const BasicHashedStringParam<Char>& a,
+		const BasicHashedStringParam<Char>& b) {
+	return a.hash() == b.hash() && std::basic_string_view<Char>(a) ==
+		std::basic_string_view<Char>(b);
+}
+
+template<typename Char>
+constexpr bool operator!=(const BasicHashedStringParam<Char>& a,
+		const BasicHashedStringParam<Char>& b) {
+	return !(a == b);
+}
+
+using HashedStringParam = BasicHashedStringParam<char>;
+using HashedStringParam32 = BasicHashedStringParam<char32_t>;
+using HashedStringParam16 = BasicHashedStringParam<char16_t>;
+
 } // namespace nytl
 
+namespace std {
+
+template<typename Char>
+struct hash<nytl::BasicHashedStringParam<Char>> {
+	std::size_t operator()(
+			const nytl::BasicHashedStringParam<Char>& param) const noexcept {
+		return std::size_t(param.hash());
+	}
+};
+
+} // namespace std
+
 #endif // header guard
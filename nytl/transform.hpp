@@ -5,8 +5,10 @@
 #include <nytl/vecOps.hpp>
 #include <nytl/matOps.hpp>
 #include <nytl/quaternion.hpp>
+#include <nytl/span.hpp>
 #include <cmath>
 #include <cassert>
+#include <type_traits>
 
 // Implements all kinds of useful 2D and 3D transforms and
 // matrix creation functions, projections, lookAt matrix and so on.
@@ -54,6 +56,63 @@ Vec3<P> multPos(const Mat4<P>& m, Vec3<P> v) {
 	return {v4[0] / v4[3], v4[1] / v4[3], v4[2] / v4[3]};
 }
 
+// Batch variant of multPos: transforms a whole span of positions
+// (implicit w = 1). The matrix rows are copied into locals once so they
+// stay in registers instead of being reloaded for every vector, and the
+// per-point divide only happens when the last row is not the identity
+// row, i.e. only for the projection matrices below that actually
+// produce w != 1. src and dst may be the same span.
+template<typename P>
+void transformPoints(const Mat4<P>& m,
+		span<const Vec3<P>> src, span<Vec3<P>> dst) {
+	assert(src.size() == dst.size());
+	const auto r0 = m[0];
+	const auto r1 = m[1];
+	const auto r2 = m[2];
+	const auto r3 = m[3];
+	const auto affine = r3 == Vec4<P> {P(0.0), P(0.0), P(0.0), P(1.0)};
+
+	if(affine) {
+		for(auto i = 0u; i < src.size(); ++i) {
+			const auto v = src[i];
+			dst[i] = {
+				r0[0] * v.x + r0[1] * v.y + r0[2] * v.z + r0[3],
+				r1[0] * v.x + r1[1] * v.y + r1[2] * v.z + r1[3],
+				r2[0] * v.x + r2[1] * v.y + r2[2] * v.z + r2[3]};
+		}
+
+		return;
+	}
+
+	for(auto i = 0u; i < src.size(); ++i) {
+		const auto v = src[i];
+		const auto w = r3[0] * v.x + r3[1] * v.y + r3[2] * v.z + r3[3];
+		dst[i] = {
+			(r0[0] * v.x + r0[1] * v.y + r0[2] * v.z + r0[3]) / w,
+			(r1[0] * v.x + r1[1] * v.y + r1[2] * v.z + r1[3]) / w,
+			(r2[0] * v.x + r2[1] * v.y + r2[2] * v.z + r2[3]) / w};
+	}
+}
+
+// Like transformPoints but for directions (implicit w = 0): only the
+// upper 3x3 part applies, no translation and never a divide.
+template<typename P>
+void transformDirections(const Mat4<P>& m,
+		span<const Vec3<P>> src, span<Vec3<P>> dst) {
+	assert(src.size() == dst.size());
+	const auto r0 = m[0];
+	const auto r1 = m[1];
+	const auto r2 = m[2];
+
+	for(auto i = 0u; i < src.size(); ++i) {
+		const auto v = src[i];
+		dst[i] = {
+			r0[0] * v.x + r0[1] * v.y + r0[2] * v.z,
+			r1[0] * v.x + r1[1] * v.y + r1[2] * v.z,
+			r2[0] * v.x + r2[1] * v.y + r2[2] * v.z};
+	}
+}
+
 // Given a unit vector, returns two unit vectors that are orthogonal
 // to it.
 template<typename P> [[nodiscard]]
@@ -533,6 +592,132 @@ SquareMat<D, P> lookAt(const Vec3<P>& z, const Vec3<P>& up) {
 	return ret;
 }
 
+// Decomposed translation/rotation/scale transform with a lazily
+// composed, cached matrix.
+// In difference to chaining the free translate/rotate/scale mutators
+// above (each a full matrix multiply), the components are stored
+// separately and the homogeneous (D+1)x(D+1) matrix is only composed
+// when requested and a component changed since the last composition.
+// Translation updates additionally patch the cached matrix directly
+// instead of dirtying it, since they only touch the last column.
+// Rotation is a Quaternion for D == 3 and a plain angle (in radians,
+// counter-clockwise) for D == 2.
+template<size_t D, typename P = float>
+class Transform {
+public:
+	static_assert(D == 2 || D == 3);
+	using Rotation = std::conditional_t<D == 3, Quaternion, P>;
+	using Mat = SquareMat<D + 1, P>;
+
+public:
+	Transform() {
+		for(auto i = 0u; i < D; ++i) {
+			scale_[i] = P(1.0);
+		}
+	}
+
+	// - incremental updates -
+	// Moves the transform by the given offset.
+	// Does not invalidate the cached matrix, only patches it.
+	void translate(const Vec<D, P>& t) {
+		translation_ += t;
+		if(!dirty_) {
+			for(auto i = 0u; i < D; ++i) {
+				matrix_[i][D] += t[i];
+			}
+		}
+	}
+
+	// Applies the given rotation on top of the current one.
+	void rotate(const Rotation& r) {
+		if constexpr(D == 3) {
+			rotation_ = r * rotation_;
+		} else {
+			rotation_ += r;
+		}
+		dirty_ = true;
+	}
+
+	// Scales the transform component-wise by the given factors.
+	void scale(const Vec<D, P>& s) {
+		for(auto i = 0u; i < D; ++i) {
+			scale_[i] *= s[i];
+		}
+		dirty_ = true;
+	}
+
+	// - setters -
+	void translation(const Vec<D, P>& t) {
+		if(!dirty_) {
+			for(auto i = 0u; i < D; ++i) {
+				matrix_[i][D] = t[i];
+			}
+		}
+		translation_ = t;
+	}
+
+	void rotation(const Rotation& r) {
+		rotation_ = r;
+		dirty_ = true;
+	}
+
+	void scaling(const Vec<D, P>& s) {
+		scale_ = s;
+		dirty_ = true;
+	}
+
+	// - observers -
+	[[nodiscard]] const Vec<D, P>& translation() const { return translation_; }
+	[[nodiscard]] const Rotation& rotation() const { return rotation_; }
+	[[nodiscard]] const Vec<D, P>& scaling() const { return scale_; }
+	[[nodiscard]] bool dirty() const { return dirty_; }
+
+	// Returns the composed homogeneous transform matrix
+	// (translation * rotation * scale). Recomposes only when a
+	// component changed since the last call.
+	[[nodiscard]] const Mat& matrix() const {
+		if(dirty_) {
+			compose();
+		}
+		return matrix_;
+	}
+
+protected:
+	void compose() const {
+		if constexpr(D == 3) {
+			matrix_ = toMat<4, P>(rotation_);
+		} else {
+			const auto c = std::cos(rotation_);
+			const auto s = std::sin(rotation_);
+			matrix_ = identity<3, P>();
+			matrix_[0][0] = c;
+			matrix_[0][1] = -s;
+			matrix_[1][0] = s;
+			matrix_[1][1] = c;
+		}
+
+		// scale the rotation columns, set the translation column
+		for(auto i = 0u; i < D; ++i) {
+			for(auto j = 0u; j < D; ++j) {
+				matrix_[i][j] *= scale_[j];
+			}
+			matrix_[i][D] = translation_[i];
+		}
+
+		dirty_ = false;
+	}
+
+	Vec<D, P> translation_ {};
+	Vec<D, P> scale_ {};
+	Rotation rotation_ {};
+
+	mutable Mat matrix_ = identity<D + 1, P>();
+	mutable bool dirty_ {false};
+};
+
+using Transform2 = Transform<2, float>;
+using Transform3 = Transform<3, float>;
+
 } // namespace
 
 
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <nytl/mat.hpp>
+#include <nytl/matOps.hpp>
+#include <nytl/span.hpp>
+#include <nytl/bytes.hpp>
+
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+#include <cassert>
+
+// Flat transform hierarchy with a linear update pass.
+// Complements the single-node nytl::Transform from nytl/transform.hpp:
+// instead of multiplying matrix chains node-by-node through pointers,
+// all local and world matrices live in flat arrays ordered so that
+// parents always precede their children. Updating the whole hierarchy
+// is then one forward sweep over contiguous memory that only touches
+// dirty subtrees, and the world matrices can be uploaded to the GPU
+// directly as one span of bytes.
+
+namespace nytl {
+
+template<typename P = float>
+class TransformTree {
+public:
+	using Matrix = Mat4<P>;
+	using NodeID = std::uint32_t;
+	static constexpr NodeID noParent = 0xFFFFFFFFu;
+
+public:
+	// Adds a new node with the given parent (noParent for a root node)
+	// and local transform, returns its id.
+	// The parent must already exist, which guarantees that parents
+	// precede their children in the flat arrays.
+	NodeID add(NodeID parent = noParent, const Matrix& local = identity<4, P>()) {
+		assert(parent == noParent || parent < local_.size());
+		auto id = NodeID(local_.size());
+		local_.push_back(local);
+		world_.push_back(local);
+		parent_.push_back(parent);
+		dirty_.push_back(1u);
+		return id;
+	}
+
+	// Sets the local transform of the given node.
+	// The world matrices of the node and its subtree are updated
+	// during the next update sweep.
+	void local(NodeID node, const Matrix& m) {
+		assert(node < local_.size());
+		local_[node] = m;
+		dirty_[node] = 1u;
+	}
+
+	[[nodiscard]] const Matrix& local(NodeID node) const {
+		assert(node < local_.size());
+		return local_[node];
+	}
+
+	// Returns the world transform of the given node as of the last
+	// update sweep.
+	[[nodiscard]] const Matrix& world(NodeID node) const {
+		assert(node < world_.size());
+		return world_[node];
+	}
+
+	// Recomputes the world matrices in one linear sweep.
+	// A node is recomposed when its local transform changed or an
+	// ancestor was recomposed, clean subtrees are skipped.
+	// Returns the number of recomposed nodes.
+	std::size_t update() {
+		auto count = std::size_t {0};
+		for(auto i = std::size_t {0}; i < local_.size(); ++i) {
+			auto parent = parent_[i];
+
+			// since parents precede children, dirty_[parent] already
+			// holds whether the parent was recomposed in this sweep
+			auto recompose = dirty_[i] ||
+				(parent != noParent && dirty_[parent]);
+			if(recompose) {
+				world_[i] = (parent == noParent) ?
+					local_[i] : world_[parent] * local_[i];
+				++count;
+			}
+
+			dirty_[i] = recompose;
+		}
+
+		// reset the recompose markers for the next sweep
+		std::fill(dirty_.begin(), dirty_.end(), std::uint8_t {0});
+		return count;
+	}
+
+	// The world matrices of all nodes (in hierarchy order), e.g. for
+	// direct GPU upload. Only valid until the next add().
+	[[nodiscard]] span<const Matrix> worldMatrices() const { return world_; }
+	[[nodiscard]] span<const Matrix> localMatrices() const { return local_; }
+
+	// The world matrices as raw bytes, see nytl/bytes.hpp.
+	[[nodiscard]] ReadBuf worldBytes() const {
+		return bytes(span<const Matrix>(world_));
+	}
+
+	[[nodiscard]] std::size_t size() const { return local_.size(); }
+	[[nodiscard]] bool empty() const { return local_.empty(); }
+
+	void reserve(std::size_t size) {
+		local_.reserve(size);
+		world_.reserve(size);
+		parent_.reserve(size);
+		dirty_.reserve(size);
+	}
+
+	void clear() {
+		local_.clear();
+		world_.clear();
+		parent_.clear();
+		dirty_.clear();
+	}
+
+protected:
+	std::vector<Matrix> local_; // node-local transforms
+	std::vector<Matrix> world_; // composed world transforms
+	std::vector<NodeID> parent_; // parent ids, noParent for roots
+	std::vector<std::uint8_t> dirty_; // nodes to recompose next sweep
+};
+
+} // namespace nytl
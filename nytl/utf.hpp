@@ -9,14 +9,18 @@
 #ifndef NYTL_INCLUDE_UTF
 #define NYTL_INCLUDE_UTF
 
+#include <nytl/span.hpp> // nytl::span
+
 #include <string> // std::string
 #include <string_view> // std::string_view
 #include <array> // std::array
-#include <locale> // std::wstring_convert
-#include <codecvt> // std::codecvt_utf8
+#include <vector> // std::vector
 #include <stdexcept> // std::out_of_range
+#include <cstring> // std::memcpy
+#include <cstdint> // std::uint64_t
 
-// all operations assume correct utf8 string and don't perform any sanity checks.
+// all operations (except validUtf8) assume correct utf8 string and don't
+// perform any sanity checks.
 // for implementation details see https://en.wikipedia.org/wiki/UTF-8
 
 namespace nytl {
@@ -24,26 +28,116 @@ namespace nytl {
 /// \brief Returns the number of characters in a utf8-encoded unicode string.
 /// This differs from std::string::size because it does not return the bytes in the
 /// string, but the count of utf8-encoded characters.
+/// Characters are counted chunk-wise (8 bytes per iteration, swar) by
+/// counting the bytes that are not utf8 continuation bytes.
 inline std::size_t charCount(std::string_view utf8) {
+	constexpr auto ones = std::uint64_t {0x0101010101010101};
+	auto data = utf8.data();
+	auto size = utf8.size();
 	std::size_t count = 0u;
-	auto it = utf8.begin();
 
-	while(it != utf8.end()) {
-		auto length = 1u;
-		if((*it) & (1 << 7)) {
-			++length;
-			if((*it) & (1 << 5)) {
-				++length;
-				if((*it) & (1 << 4))
-					++length;
+	auto i = std::size_t {0};
+	for(; i + 8 <= size; i += 8) {
+		// mark continuation bytes (0b10xxxxxx), sum them up via the
+		// multiply and subtract them from the chunk size
+		std::uint64_t chunk;
+		std::memcpy(&chunk, data + i, 8);
+		auto cont = (chunk >> 7) & ~(chunk >> 6) & ones;
+		count += 8 - ((cont * ones) >> 56);
+	}
+
+	for(; i < size; ++i) {
+		count += (static_cast<unsigned char>(data[i]) & 0xc0) != 0x80;
+	}
+
+	return count;
+}
+
+/// \brief Returns whether the given string is valid utf8.
+/// Checks lead/continuation byte structure, overlong encodings,
+/// surrogate codepoints and the unicode range. Pure ascii segments are
+/// skipped 8 bytes per iteration.
+inline bool validUtf8(std::string_view utf8) {
+	auto data = reinterpret_cast<const unsigned char*>(utf8.data());
+	auto size = utf8.size();
+
+	auto i = std::size_t {0};
+	while(i < size) {
+		// ascii fast path: skip whole chunks without a high bit
+		while(i + 8 <= size) {
+			std::uint64_t chunk;
+			std::memcpy(&chunk, data + i, 8);
+			if(chunk & std::uint64_t {0x8080808080808080}) {
+				break;
 			}
+			i += 8;
 		}
 
-		++count;
-		it += length;
+		if(i == size) {
+			break;
+		}
+
+		auto lead = data[i];
+		if(lead < 0x80) {
+			++i;
+			continue;
+		}
+
+		auto length = 0u;
+		auto cp = std::uint32_t {0};
+		if((lead & 0xe0) == 0xc0) {
+			length = 2;
+			cp = lead & 0x1f;
+		} else if((lead & 0xf0) == 0xe0) {
+			length = 3;
+			cp = lead & 0x0f;
+		} else if((lead & 0xf8) == 0xf0) {
+			length = 4;
+			cp = lead & 0x07;
+		} else { // continuation byte or invalid lead
+			return false;
+		}
+
+		if(i + length > size) { // truncated sequence
+			return false;
+		}
+
+		for(auto j = 1u; j < length; ++j) {
+			if((data[i + j] & 0xc0) != 0x80) {
+				return false;
+			}
+			cp = (cp << 6) | (data[i + j] & 0x3f);
+		}
+
+		constexpr std::uint32_t mins[] = {0x80, 0x800, 0x10000};
+		if(cp < mins[length - 2]) { // overlong encoding
+			return false;
+		}
+		if((cp >= 0xd800 && cp <= 0xdfff) || cp > 0x10ffff) {
+			return false;
+		}
+
+		i += length;
 	}
 
-	return count;
+	return true;
+}
+
+/// \brief Returns the byte offsets of all characters in the given utf8 string.
+/// I.e. ret[n] is the byte position of the nth utf8 character, ret.size()
+/// equals charCount(utf8). Can be built once per string to make repeated
+/// character indexing O(1).
+inline std::vector<std::size_t> charOffsets(std::string_view utf8) {
+	std::vector<std::size_t> ret;
+	ret.reserve(utf8.size());
+
+	for(auto i = std::size_t {0}; i < utf8.size(); ++i) {
+		if((static_cast<unsigned char>(utf8[i]) & 0xc0) != 0x80) {
+			ret.push_back(i);
+		}
+	}
+
+	return ret;
 }
 
 /// \brief Returns the character at position n (started at 0) from the given utf8 string.
@@ -154,38 +248,395 @@ inline char& nth(std::string& utf8, std::size_t n, std::uint8_t& size) {
 	throw std::out_of_range("nytl::nth(utf8, n, size)");
 }
 
+/// Incremental cursor over the characters of a utf8 string.
+/// In difference to the nth() functions, which rescan the string from
+/// the start on every call, the cursor remembers its position, so
+/// sequential traversal (in both directions) is O(1) per step.
+/// The referenced string must stay valid while the cursor is used.
+class Utf8Cursor {
+public:
+	Utf8Cursor() = default;
+	Utf8Cursor(std::string_view utf8) : str_(utf8) {}
+
+	/// Advances the cursor to the next character.
+	/// Returns false (and does nothing) when already at the end.
+	bool next() {
+		if(byte_ >= str_.size()) {
+			return false;
+		}
+
+		++byte_;
+		while(byte_ < str_.size() && cont(str_[byte_])) {
+			++byte_;
+		}
+
+		++char_;
+		return true;
+	}
+
+	/// Moves the cursor back to the previous character.
+	/// Returns false (and does nothing) when already at the start.
+	bool prev() {
+		if(byte_ == 0) {
+			return false;
+		}
+
+		--byte_;
+		while(byte_ > 0 && cont(str_[byte_])) {
+			--byte_;
+		}
+
+		--char_;
+		return true;
+	}
+
+	/// Moves the cursor to the nth character, stepping incrementally
+	/// from the current position.
+	void seek(std::size_t n) {
+		while(char_ < n && next());
+		while(char_ > n) {
+			prev();
+		}
+	}
+
+	/// Returns the character under the cursor, same format as
+	/// nth(utf8, n): utf8 bytes followed by a '\0'.
+	/// The cursor must not be at the end of the string.
+	std::array<char, 5> current() const {
+		std::array<char, 5> ret {};
+		ret[0] = str_[byte_];
+		for(auto i = byte_ + 1; i < str_.size() && cont(str_[i]); ++i) {
+			ret[i - byte_] = str_[i];
+		}
+
+		return ret;
+	}
+
+	/// Current character and byte position of the cursor.
+	std::size_t charPosition() const { return char_; }
+	std::size_t byteOffset() const { return byte_; }
+
+	/// Whether the cursor is past the last character.
+	bool atEnd() const { return byte_ >= str_.size(); }
+
+protected:
+	static bool cont(char c) {
+		return (static_cast<unsigned char>(c) & 0xc0) == 0x80;
+	}
+
+	std::string_view str_ {};
+	std::size_t byte_ {}; // byte offset of the current character
+	std::size_t char_ {}; // character position of the current character
+};
+
+/// Sparse character-to-byte-offset index over a utf8 string.
+/// Stores the byte offset of every strideth character (one scan at
+/// construction), which makes random character access O(stride) instead
+/// of O(n) while only costing size/stride extra memory.
+/// The referenced string must stay valid while the index is used.
+class Utf8Index {
+public:
+	Utf8Index() = default;
+	Utf8Index(std::string_view utf8, std::size_t stride = 16) :
+			str_(utf8), stride_(stride) {
+		for(auto i = std::size_t {0}; i < utf8.size(); ++i) {
+			if((static_cast<unsigned char>(utf8[i]) & 0xc0) != 0x80) {
+				if(count_ % stride_ == 0) {
+					offsets_.push_back(i);
+				}
+				++count_;
+			}
+		}
+	}
+
+	/// Returns the byte offset of the nth character.
+	/// \throws std::out_of_range for n > charCount().
+	std::size_t byteOffset(std::size_t n) const {
+		if(n > count_) {
+			throw std::out_of_range("nytl::Utf8Index::byteOffset");
+		} else if(n == count_) {
+			return str_.size();
+		}
+
+		// jump to the nearest indexed character, scan the rest
+		auto off = offsets_[n / stride_];
+		for(auto i = n % stride_; i > 0;) {
+			++off;
+			if((static_cast<unsigned char>(str_[off]) & 0xc0) != 0x80) {
+				--i;
+			}
+		}
+
+		return off;
+	}
+
+	/// Returns the nth character, same format as nth(utf8, n).
+	/// \throws std::out_of_range for n >= charCount().
+	std::array<char, 5> nth(std::size_t n) const {
+		if(n >= count_) {
+			throw std::out_of_range("nytl::Utf8Index::nth");
+		}
+
+		auto off = byteOffset(n);
+		std::array<char, 5> ret {};
+		ret[0] = str_[off];
+		for(auto i = off + 1; i < str_.size() &&
+				(static_cast<unsigned char>(str_[i]) & 0xc0) == 0x80; ++i) {
+			ret[i - off] = str_[i];
+		}
+
+		return ret;
+	}
+
+	/// Returns the number of characters in the indexed string.
+	std::size_t charCount() const { return count_; }
+
+protected:
+	std::string_view str_ {};
+	std::size_t stride_ {16};
+	std::size_t count_ {};
+	std::vector<std::size_t> offsets_; // byte offsets of every strideth char
+};
+
+namespace detail {
+
+// Encodes the given codepoint as utf8, writes 1-4 bytes into 'out'.
+// Returns the number of written bytes.
+inline std::size_t encodeUtf8(char32_t cp, char* out) {
+	if(cp < 0x80) {
+		out[0] = static_cast<char>(cp);
+		return 1;
+	} else if(cp < 0x800) {
+		out[0] = static_cast<char>(0xc0 | (cp >> 6));
+		out[1] = static_cast<char>(0x80 | (cp & 0x3f));
+		return 2;
+	} else if(cp < 0x10000) {
+		out[0] = static_cast<char>(0xe0 | (cp >> 12));
+		out[1] = static_cast<char>(0x80 | ((cp >> 6) & 0x3f));
+		out[2] = static_cast<char>(0x80 | (cp & 0x3f));
+		return 3;
+	}
+
+	out[0] = static_cast<char>(0xf0 | (cp >> 18));
+	out[1] = static_cast<char>(0x80 | ((cp >> 12) & 0x3f));
+	out[2] = static_cast<char>(0x80 | ((cp >> 6) & 0x3f));
+	out[3] = static_cast<char>(0x80 | (cp & 0x3f));
+	return 4;
+}
+
+// Decodes the utf8 sequence starting at 'it', advances it past the sequence.
+inline char32_t decodeUtf8(const char*& it) {
+	auto lead = static_cast<unsigned char>(*it++);
+	if(lead < 0x80) {
+		return lead;
+	}
+
+	auto length = 2u;
+	auto cp = char32_t {};
+	if((lead & 0xe0) == 0xc0) {
+		cp = lead & 0x1f;
+	} else if((lead & 0xf0) == 0xe0) {
+		length = 3u;
+		cp = lead & 0x0f;
+	} else {
+		length = 4u;
+		cp = lead & 0x07;
+	}
+
+	for(auto i = 1u; i < length; ++i) {
+		cp = (cp << 6) | (static_cast<unsigned char>(*it++) & 0x3f);
+	}
+
+	return cp;
+}
+
+// Encodes the given codepoint as utf16, writes 1-2 units into 'out'.
+// Returns the number of written units.
+inline std::size_t encodeUtf16(char32_t cp, char16_t* out) {
+	if(cp < 0x10000) {
+		out[0] = static_cast<char16_t>(cp);
+		return 1;
+	}
+
+	cp -= 0x10000;
+	out[0] = static_cast<char16_t>(0xd800 | (cp >> 10));
+	out[1] = static_cast<char16_t>(0xdc00 | (cp & 0x3ff));
+	return 2;
+}
+
+// Decodes the utf16 sequence starting at 'it', advances it past the sequence.
+inline char32_t decodeUtf16(const char16_t*& it) {
+	auto lead = char32_t {*it++};
+	if(lead < 0xd800 || lead > 0xdbff) {
+		return lead;
+	}
+
+	auto trail = char32_t {*it++};
+	return 0x10000 + (((lead - 0xd800) << 10) | (trail - 0xdc00));
+}
+
+} // namespace detail
+
+// The buffer-writing conversion overloads below never allocate, they
+// write into the given output span and return the number of written
+// units. When the output is too small, conversion stops before the
+// first character that would not fit completely.
+// Sufficient bounds: toUtf8 needs at most 3 bytes per utf16 unit or
+// 4 bytes per codepoint, toUtf16 at most 1 unit per utf8 byte or 2
+// units per codepoint, toUtf32 at most 1 unit per input unit.
+
+/// \brief Converts the given utf16 string to utf8, written into 'out'.
+inline std::size_t toUtf8(std::u16string_view utf16, span<char> out) {
+	auto it = utf16.data();
+	auto end = it + utf16.size();
+	auto written = std::size_t {0};
+	char buf[4];
+
+	while(it != end) {
+		auto count = detail::encodeUtf8(detail::decodeUtf16(it), buf);
+		if(written + count > out.size()) {
+			break;
+		}
+
+		for(auto i = 0u; i < count; ++i) {
+			out[written++] = buf[i];
+		}
+	}
+
+	return written;
+}
+
+/// \brief Converts the given utf32 string to utf8, written into 'out'.
+inline std::size_t toUtf8(std::u32string_view utf32, span<char> out) {
+	auto written = std::size_t {0};
+	char buf[4];
+
+	for(auto cp : utf32) {
+		auto count = detail::encodeUtf8(cp, buf);
+		if(written + count > out.size()) {
+			break;
+		}
+
+		for(auto i = 0u; i < count; ++i) {
+			out[written++] = buf[i];
+		}
+	}
+
+	return written;
+}
+
+/// \brief Converts the given utf8 string to utf16, written into 'out'.
+inline std::size_t toUtf16(std::string_view utf8, span<char16_t> out) {
+	auto it = utf8.data();
+	auto end = it + utf8.size();
+	auto written = std::size_t {0};
+	char16_t buf[2];
+
+	while(it != end) {
+		auto count = detail::encodeUtf16(detail::decodeUtf8(it), buf);
+		if(written + count > out.size()) {
+			break;
+		}
+
+		for(auto i = 0u; i < count; ++i) {
+			out[written++] = buf[i];
+		}
+	}
+
+	return written;
+}
+
+/// \brief Converts the given utf32 string to utf16, written into 'out'.
+inline std::size_t toUtf16(std::u32string_view utf32, span<char16_t> out) {
+	auto written = std::size_t {0};
+	char16_t buf[2];
+
+	for(auto cp : utf32) {
+		auto count = detail::encodeUtf16(cp, buf);
+		if(written + count > out.size()) {
+			break;
+		}
+
+		for(auto i = 0u; i < count; ++i) {
+			out[written++] = buf[i];
+		}
+	}
+
+	return written;
+}
+
+/// \brief Converts the given utf8 string to utf32, written into 'out'.
+inline std::size_t toUtf32(std::string_view utf8, span<char32_t> out) {
+	auto it = utf8.data();
+	auto end = it + utf8.size();
+	auto written = std::size_t {0};
+
+	while(it != end && written < out.size()) {
+		out[written++] = detail::decodeUtf8(it);
+	}
+
+	return written;
+}
+
+/// \brief Converts the given utf16 string to utf32, written into 'out'.
+inline std::size_t toUtf32(std::u16string_view utf16, span<char32_t> out) {
+	auto it = utf16.data();
+	auto end = it + utf16.size();
+	auto written = std::size_t {0};
+
+	while(it != end && written < out.size()) {
+		out[written++] = detail::decodeUtf16(it);
+	}
+
+	return written;
+}
+
 /// \brief Converts the given utf16 string to a utf8 string.
 inline std::string toUtf8(std::u16string_view utf16) {
-	std::wstring_convert<std::codecvt_utf8_utf16<char16_t>, char16_t> converter;
-	return converter.to_bytes(utf16.begin(), utf16.end());
+	std::string ret;
+	ret.resize(3 * utf16.size());
+	ret.resize(toUtf8(utf16, {ret.data(), ret.size()}));
+	return ret;
 }
 
 /// \brief Converts the given utf32 string to a utf8 string.
 inline std::string toUtf8(std::u32string_view utf32) {
-	std::wstring_convert<std::codecvt_utf8<char32_t>, char32_t> converter;
-	return converter.to_bytes(utf32.begin(), utf32.end());
+	std::string ret;
+	ret.resize(4 * utf32.size());
+	ret.resize(toUtf8(utf32, {ret.data(), ret.size()}));
+	return ret;
 }
 
 /// \brief Converts the given utf8 string to a utf16 string.
 inline std::u16string toUtf16(std::string_view utf8) {
-	std::wstring_convert<std::codecvt_utf8_utf16<char16_t>, char16_t> converter;
-	return converter.from_bytes(utf8.begin(), utf8.end());
+	std::u16string ret;
+	ret.resize(utf8.size());
+	ret.resize(toUtf16(utf8, {ret.data(), ret.size()}));
+	return ret;
 }
 
 /// \brief Converts the given utf32 string to a utf16 string.
 inline std::u16string toUtf16(std::u32string_view utf32) {
-	return toUtf16(toUtf8(utf32));
+	std::u16string ret;
+	ret.resize(2 * utf32.size());
+	ret.resize(toUtf16(utf32, {ret.data(), ret.size()}));
+	return ret;
 }
 
 /// \brief Converts the given utf8 string to a utf32 string.
 inline std::u32string toUtf32(std::string_view utf8) {
-	std::wstring_convert<std::codecvt_utf8<char32_t>, char32_t> converter;
-	return converter.from_bytes(utf8.begin(), utf8.end());
+	std::u32string ret;
+	ret.resize(utf8.size());
+	ret.resize(toUtf32(utf8, {ret.data(), ret.size()}));
+	return ret;
 }
 
 /// \brief Converts the given utf16 string to a utf32 string.
 inline std::u32string toUtf32(std::u16string_view utf16) {
-	return toUtf32(toUtf8(utf16));
+	std::u32string ret;
+	ret.resize(utf16.size());
+	ret.resize(toUtf32(utf16, {ret.data(), ret.size()}));
+	return ret;
 }
 
 } // namespace nytl
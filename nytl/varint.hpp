@@ -0,0 +1,142 @@
+// Copyright (c) 2017-2020 nyorain
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt
+
+/// \file Varint and delta codecs on top of the buffers from nytl/bytes.hpp.
+
+#pragma once
+
+#ifndef NYTL_INCLUDE_VARINT
+#define NYTL_INCLUDE_VARINT
+
+#include <nytl/bytes.hpp> // nytl::ReadBuf
+#include <nytl/math.hpp> // nytl::mapUnsigned
+#include <nytl/span.hpp> // nytl::span
+
+#include <cstdint> // std::uint64_t
+#include <type_traits> // std::is_integral
+
+namespace nytl {
+
+// Maximum encoded size of a 64-bit varint, in bytes.
+constexpr auto maxVarintSize = 10u;
+
+// Writes the given value LEB128-encoded: 7 bits per byte, the high
+// bit marks a continuation. Small values take a single byte.
+// Works for DynWriteBuf and WriteBuf destinations.
+template<typename B>
+void writeVarint(B& dst, std::uint64_t val) {
+	std::byte enc[maxVarintSize];
+	auto len = 0u;
+	do {
+		auto b = val & 0x7f;
+		val >>= 7;
+		enc[len++] = std::byte(val ? (b | 0x80) : b);
+	} while(val);
+
+	write(dst, ReadBuf {enc, len});
+}
+
+// Writes the given signed value zigzag-mapped (see mapUnsigned in
+// nytl/math.hpp), so small negative values also encode small.
+template<typename B>
+void writeSignedVarint(B& dst, std::int64_t val) {
+	writeVarint(dst, mapUnsigned(val));
+}
+
+namespace detail {
+
+// Decode without per-byte bounds checks, the caller guarantees that
+// at least maxVarintSize readable bytes remain.
+inline std::uint64_t decodeVarintFast(const std::byte*& data) {
+	auto ret = std::uint64_t(*data) & 0x7f;
+	if(!(std::uint64_t(*data++) & 0x80)) {
+		return ret;
+	}
+
+	for(auto shift = 7u; shift < 7 * maxVarintSize; shift += 7) {
+		ret |= (std::uint64_t(*data) & 0x7f) << shift;
+		if(!(std::uint64_t(*data++) & 0x80)) {
+			break;
+		}
+	}
+
+	return ret;
+}
+
+} // namespace detail
+
+// Reads a LEB128-encoded value, advancing the buffer.
+inline std::uint64_t readVarint(ReadBuf& src) {
+	auto ret = std::uint64_t {0};
+	auto shift = 0u;
+	auto cont = true;
+	while(cont) {
+		NYTL_BYTES_ASSERT(!src.empty() && shift < 7 * maxVarintSize);
+		auto b = std::uint64_t(src[0]);
+		ret |= (b & 0x7f) << shift;
+		shift += 7;
+		cont = (b & 0x80) != 0;
+		skip(src, 1);
+	}
+
+	return ret;
+}
+
+// Reads a zigzag-mapped signed varint, advancing the buffer.
+inline std::int64_t readSignedVarint(ReadBuf& src) {
+	return unmapUnsigned(readVarint(src));
+}
+
+// Writes the given values delta-encoded: the first value verbatim,
+// every further one as zigzag varint of its difference to the
+// predecessor. Monotonically increasing sequences with small steps
+// (ids, timestamps) shrink to roughly a byte per value.
+template<typename B, typename T>
+std::enable_if_t<std::is_integral_v<T>>
+writeDelta(B& dst, span<const T> values) {
+	writeVarint(dst, std::uint64_t(values.size()));
+	auto prev = std::uint64_t {0};
+	for(auto v : values) {
+		writeVarint(dst, mapUnsigned(std::int64_t(std::uint64_t(v) - prev)));
+		prev = std::uint64_t(v);
+	}
+}
+
+// Reads a delta-encoded sequence written by writeDelta into 'dst'.
+// Returns the stored value count; at most dst.size() values are
+// written, the rest is decoded but dropped.
+template<typename T>
+std::enable_if_t<std::is_integral_v<T>, std::size_t>
+readDelta(ReadBuf& src, span<T> dst) {
+	auto count = std::size_t(readVarint(src));
+	auto prev = std::uint64_t {0};
+
+	auto i = std::size_t {0};
+	auto data = src.data();
+	auto end = src.data() + src.size();
+	for(; i < count; ++i) {
+		std::uint64_t delta;
+		if(std::size_t(end - data) >= maxVarintSize) {
+			// fast path: enough readable bytes for any varint, no
+			// per-byte bounds checking
+			delta = detail::decodeVarintFast(data);
+		} else {
+			auto tail = ReadBuf {data, std::size_t(end - data)};
+			delta = readVarint(tail);
+			data = tail.data();
+		}
+
+		prev += std::uint64_t(unmapUnsigned(delta));
+		if(i < dst.size()) {
+			dst[i] = T(prev);
+		}
+	}
+
+	skip(src, data - src.data());
+	return count;
+}
+
+} // namespace nytl
+
+#endif // header guard
@@ -14,6 +14,7 @@
 // specializations
 #include <nytl/vec2.hpp> // nytl::Vec<2, T>
 #include <nytl/vec3.hpp> // nytl::Vec<3, T>
+#include <nytl/vec4.hpp> // nytl::Vec<4, T>
 
 #include <array> // std::array
 #include <algorithm> // std::min
@@ -25,7 +26,7 @@ namespace nytl {
 /// and utility provided for dealing with it.
 /// \module vec
 template<size_t D, typename T>
-class Vec : public std::array<T, D> {
+class alignas(detail::vecAlign<D, T>) Vec : public std::array<T, D> {
 public:
 	/// The (static/fixed) size of the type
 	static constexpr size_t size() { return D; }
@@ -18,8 +18,10 @@ namespace nytl {
 /// Specialization for 2 component Vec.
 /// Holds x,y members that are more convenient to access.
 /// Compatible with the default class definition.
+/// With NYTL_VEC_ALIGN_SIMD defined (see fwd/vec.hpp), e.g. Vec<2, double>
+/// is aligned to its full 16 bytes for vectorized operator loops.
 template<typename T>
-class Vec<2, T> {
+class alignas(detail::vecAlign<2, T>) Vec<2, T> {
 public:
 	T x;
 	T y;
@@ -0,0 +1,185 @@
+// Copyright (c) 2017-2020 nyorain
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt
+
+/// \file Batch versions of the vecOps operations over many vectors.
+/// The single-pair operations from nytl/vecOps.hpp don't vectorize over
+/// multiple vectors, this file provides kernels that process whole arrays.
+
+#pragma once
+
+#ifndef NYTL_INCLUDE_VEC_BATCH_OPS
+#define NYTL_INCLUDE_VEC_BATCH_OPS
+
+#include <nytl/vec.hpp> // nytl::Vec
+#include <nytl/vecOps.hpp> // nytl::dot
+#include <nytl/span.hpp> // nytl::span
+#include <nytl/kernels.hpp> // nytl::kernels
+
+#include <vector> // std::vector
+#include <cmath> // std::sqrt
+#include <cassert> // assert
+#include <type_traits> // std::is_same
+
+namespace nytl {
+
+/// Structure-of-arrays storage for a batch of D-dimensional vectors.
+/// Every component lives in its own contiguous array. In difference to a
+/// plain array of Vec this layout allows the batch operations below to be
+/// vectorized over multiple vectors per iteration (an array of Vec3f e.g.
+/// wastes a simd lane and prevents that).
+/// All components arrays always have the same size.
+template<size_t D, typename T>
+struct VecSoA {
+	std::array<std::vector<T>, D> components;
+
+	std::size_t size() const { return components[0].size(); }
+	bool empty() const { return components[0].empty(); }
+
+	void resize(std::size_t count) {
+		for(auto& c : components)
+			c.resize(count);
+	}
+
+	void reserve(std::size_t count) {
+		for(auto& c : components)
+			c.reserve(count);
+	}
+
+	void clear() {
+		for(auto& c : components)
+			c.clear();
+	}
+
+	void push_back(const Vec<D, T>& v) {
+		for(auto i = 0u; i < D; ++i)
+			components[i].push_back(v[i]);
+	}
+
+	/// Gathers the ith vector from the component arrays.
+	Vec<D, T> operator[](std::size_t i) const {
+		Vec<D, T> ret {};
+		for(auto d = 0u; d < D; ++d)
+			ret[d] = components[d][i];
+		return ret;
+	}
+
+	/// Scatters the given vector to position i of the component arrays.
+	void set(std::size_t i, const Vec<D, T>& v) {
+		for(auto d = 0u; d < D; ++d)
+			components[d][i] = v[d];
+	}
+
+	/// Returns the contiguous array of the dth component.
+	span<T> component(std::size_t d) { return components[d]; }
+	span<const T> component(std::size_t d) const { return components[d]; }
+};
+
+/// Computes the dot products of all vector pairs in a and b.
+/// The spans must all have the same size.
+template<size_t D, typename T>
+void dot(const VecSoA<D, T>& a, const VecSoA<D, T>& b, span<T> out) {
+	assert(a.size() == b.size() && a.size() == out.size());
+
+	// the float loops live in kernels.hpp so builds with the 'kernels'
+	// option get the runtime-dispatched versions
+	if constexpr(std::is_same_v<T, float>) {
+		kernels::mulSpan(a.components[0].data(), b.components[0].data(),
+			out.data(), out.size());
+		for(auto d = 1u; d < D; ++d) {
+			kernels::fmaddSpan(a.components[d].data(),
+				b.components[d].data(), out.data(), out.size());
+		}
+
+		return;
+	}
+
+	for(auto i = 0u; i < out.size(); ++i)
+		out[i] = a.components[0][i] * b.components[0][i];
+	for(auto d = 1u; d < D; ++d) {
+		auto* pa = a.components[d].data();
+		auto* pb = b.components[d].data();
+		for(auto i = 0u; i < out.size(); ++i)
+			out[i] += pa[i] * pb[i];
+	}
+}
+
+/// Computes the euclidean norms of all vectors in a.
+template<size_t D, typename T>
+void length(const VecSoA<D, T>& a, span<T> out) {
+	dot(a, a, out);
+	if constexpr(std::is_same_v<T, float>) {
+		kernels::sqrtSpan(out.data(), out.size());
+		return;
+	}
+
+	for(auto& v : out)
+		v = std::sqrt(v);
+}
+
+/// Computes the euclidean distances of all vector pairs in a and b.
+template<size_t D, typename T>
+void distance(const VecSoA<D, T>& a, const VecSoA<D, T>& b, span<T> out) {
+	assert(a.size() == b.size() && a.size() == out.size());
+	for(auto i = 0u; i < out.size(); ++i)
+		out[i] = T {0};
+	for(auto d = 0u; d < D; ++d) {
+		auto* pa = a.components[d].data();
+		auto* pb = b.components[d].data();
+		for(auto i = 0u; i < out.size(); ++i) {
+			auto diff = pa[i] - pb[i];
+			out[i] += diff * diff;
+		}
+	}
+	for(auto& v : out)
+		v = std::sqrt(v);
+}
+
+/// Normalizes all vectors in a in place.
+/// Undefined if any of the vectors is the nullvector.
+template<size_t D, typename T>
+void normalize(VecSoA<D, T>& a) {
+	std::vector<T> inv(a.size());
+	dot(a, a, span<T>(inv));
+	for(auto& v : inv)
+		v = T {1.0} / std::sqrt(v);
+	for(auto d = 0u; d < D; ++d) {
+		auto* pa = a.components[d].data();
+		for(auto i = 0u; i < inv.size(); ++i)
+			pa[i] *= inv[i];
+	}
+}
+
+// The same kernels for plain arrays of Vec. These cannot use the simd
+// lanes as well as the SoA layout above but still save the per-call
+// overhead and keep the data walk linear.
+template<size_t D, typename T>
+void dot(span<const Vec<D, T>> a, span<const Vec<D, T>> b, span<T> out) {
+	assert(a.size() == b.size() && a.size() == out.size());
+	for(auto i = 0u; i < out.size(); ++i)
+		out[i] = dot(a[i], b[i]);
+}
+
+template<size_t D, typename T>
+void length(span<const Vec<D, T>> a, span<T> out) {
+	assert(a.size() == out.size());
+	for(auto i = 0u; i < out.size(); ++i)
+		out[i] = length(a[i]);
+}
+
+template<size_t D, typename T>
+void distance(span<const Vec<D, T>> a, span<const Vec<D, T>> b, span<T> out) {
+	assert(a.size() == b.size() && a.size() == out.size());
+	for(auto i = 0u; i < out.size(); ++i)
+		out[i] = distance(a[i], b[i]);
+}
+
+template<size_t D, typename T>
+void normalize(span<Vec<D, T>> a) {
+	for(auto& v : a)
+		normalize(v);
+}
+
+} // namespace nytl
+
+#endif // header guard
@@ -0,0 +1,167 @@
+// Copyright (c) 2017-2020 nyorain
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt
+
+/// \file Opt-in lazy expression templates for Vec arithmetic.
+/// The default operators in nytl/vec.hpp return a fresh Vec per
+/// operation, i.e. `0.5 * (a + b) - c` runs three loops and materializes
+/// three temporaries. The expression layer below instead builds a
+/// lightweight expression tree that is fused into a single loop when
+/// evaluated. Since it's opt-in, the default Vec operators stay untouched;
+/// an expression is started by wrapping one operand:
+/// ```cpp
+/// auto r = vex::eval(0.5 * (vex::expr(a) + b) - c);
+/// vex::assign(v, vex::expr(a) + b); // writes into existing vec
+/// ```
+
+#pragma once
+
+#ifndef NYTL_INCLUDE_VEC_EXPR
+#define NYTL_INCLUDE_VEC_EXPR
+
+#include <nytl/vec.hpp> // nytl::Vec
+#include <nytl/tmpUtil.hpp> // nytl::validExpression
+
+#include <functional> // std::plus
+#include <type_traits> // std::enable_if
+
+namespace nytl {
+namespace vex {
+
+// Expression nodes are detected over their ExprTag typedef.
+template<typename E> using ExprTagT = typename E::ExprTag;
+template<typename E> constexpr auto isExpr = validExpression<ExprTagT, E>;
+
+/// Leaf expression, references an existing Vec.
+/// The reference must stay valid until the expression is evaluated,
+/// which is given when the whole expression is built and evaluated
+/// within one statement.
+template<size_t D, typename T>
+struct Ref {
+	using ExprTag = void;
+	const Vec<D, T>& vec;
+
+	static constexpr size_t size() { return D; }
+	constexpr decltype(auto) operator[](size_t i) const { return vec[i]; }
+};
+
+/// Component-wise binary expression over two subexpressions.
+template<typename Op, typename A, typename B>
+struct BinaryExpr {
+	using ExprTag = void;
+	A a;
+	B b;
+
+	static constexpr size_t size() { return A::size(); }
+	constexpr auto operator[](size_t i) const { return Op {}(a[i], b[i]); }
+};
+
+/// Binary expression with one scalar operand.
+template<typename Op, typename F, typename E, bool ScalarLeft>
+struct ScalarExpr {
+	using ExprTag = void;
+	F fac;
+	E e;
+
+	static constexpr size_t size() { return E::size(); }
+	constexpr auto operator[](size_t i) const {
+		if constexpr(ScalarLeft) return Op {}(fac, e[i]);
+		else return Op {}(e[i], fac);
+	}
+};
+
+/// Component-wise negation of a subexpression.
+template<typename E>
+struct NegExpr {
+	using ExprTag = void;
+	E e;
+
+	static constexpr size_t size() { return E::size(); }
+	constexpr auto operator[](size_t i) const { return -e[i]; }
+};
+
+/// Starts an expression from the given Vec.
+template<size_t D, typename T>
+constexpr Ref<D, T> expr(const Vec<D, T>& v) { return {v}; }
+
+// Wraps plain Vec operands into Ref leaves, passes expressions through.
+template<size_t D, typename T>
+constexpr Ref<D, T> asExpr(const Vec<D, T>& v) { return {v}; }
+
+template<typename E, typename = std::enable_if_t<isExpr<E>>>
+constexpr E asExpr(const E& e) { return e; }
+
+template<typename A, typename B>
+constexpr auto mixedExpr = (isExpr<A> || isExpr<B>) &&
+	!std::is_arithmetic_v<A> && !std::is_arithmetic_v<B>;
+
+// - operators, found via adl on the expression nodes -
+template<typename A, typename B,
+	typename = std::enable_if_t<mixedExpr<A, B>>>
+constexpr auto operator+(const A& a, const B& b) {
+	using EA = decltype(asExpr(a));
+	using EB = decltype(asExpr(b));
+	static_assert(EA::size() == EB::size());
+	return BinaryExpr<std::plus<>, EA, EB> {asExpr(a), asExpr(b)};
+}
+
+template<typename A, typename B,
+	typename = std::enable_if_t<mixedExpr<A, B>>>
+constexpr auto operator-(const A& a, const B& b) {
+	using EA = decltype(asExpr(a));
+	using EB = decltype(asExpr(b));
+	static_assert(EA::size() == EB::size());
+	return BinaryExpr<std::minus<>, EA, EB> {asExpr(a), asExpr(b)};
+}
+
+template<typename F, typename E>
+constexpr auto operator*(const F& f, const E& e)
+		-> std::enable_if_t<isExpr<E> && std::is_arithmetic_v<F>,
+			ScalarExpr<std::multiplies<>, F, E, true>> {
+	return {f, e};
+}
+
+template<typename E, typename F>
+constexpr auto operator*(const E& e, const F& f)
+		-> std::enable_if_t<isExpr<E> && std::is_arithmetic_v<F>,
+			ScalarExpr<std::multiplies<>, F, E, false>> {
+	return {f, e};
+}
+
+template<typename E, typename F>
+constexpr auto operator/(const E& e, const F& f)
+		-> std::enable_if_t<isExpr<E> && std::is_arithmetic_v<F>,
+			ScalarExpr<std::divides<>, F, E, false>> {
+	return {f, e};
+}
+
+template<typename E, typename = std::enable_if_t<isExpr<E>>>
+constexpr auto operator-(const E& e) {
+	return NegExpr<E> {e};
+}
+
+/// Evaluates the given expression into a new Vec in a single fused loop.
+template<typename E, typename = std::enable_if_t<isExpr<E>>>
+constexpr auto eval(const E& e) {
+	Vec<E::size(), std::decay_t<decltype(e[0])>> ret {};
+	for(auto i = 0u; i < E::size(); ++i)
+		ret[i] = e[i];
+	return ret;
+}
+
+/// Evaluates the given expression into the given Vec in a single
+/// fused loop. The target vector must not alias any vector referenced
+/// by the expression.
+template<size_t D, typename T, typename E,
+	typename = std::enable_if_t<isExpr<E>>>
+constexpr Vec<D, T>& assign(Vec<D, T>& v, const E& e) {
+	static_assert(D == E::size());
+	for(auto i = 0u; i < D; ++i)
+		v[i] = e[i];
+	return v;
+}
+
+} // namespace vex
+} // namespace nytl
+
+#endif // header guard
@@ -14,10 +14,14 @@
 #include <nytl/vec.hpp>
 #include <nytl/tmpUtil.hpp> // nytl::templatize
 #include <nytl/math.hpp> // nytl::accumulate
+#include <nytl/span.hpp> // nytl::span
 
 #include <cmath> // std::acos
 #include <iosfwd> // std::ostream
 #include <algorithm> // std::clamp
+#include <charconv> // std::to_chars
+#include <cstring> // std::memcpy
+#include <string_view> // std::string_view
 
 namespace nytl {
 
@@ -138,6 +142,61 @@ std::ostream& operator<<(std::ostream& os, const Vec<D, T>& a) {
 	return print(os, a);
 }
 
+namespace detail {
+
+/// Appends the given literal to the buffer, advancing it.
+/// Sets ok to false (and stops writing) if the buffer is too small.
+inline void formatAppend(span<char>& buf, std::string_view str, bool& ok) {
+	if(!ok || buf.size() < str.size()) {
+		ok = false;
+		return;
+	}
+
+	std::memcpy(buf.data(), str.data(), str.size());
+	buf = buf.last(buf.size() - str.size());
+}
+
+/// Appends the given value via std::to_chars, advancing the buffer.
+template<typename T>
+void formatAppend(span<char>& buf, T value, bool& ok) {
+	if(!ok) {
+		return;
+	}
+
+	auto res = std::to_chars(buf.data(), buf.data() + buf.size(), value);
+	if(res.ec != std::errc()) {
+		ok = false;
+		return;
+	}
+
+	buf = buf.last(buf.size() - (res.ptr - buf.data()));
+}
+
+} // namespace detail
+
+/// Formats the given vector into the given character buffer via
+/// std::to_chars, i.e. without allocations or locale machinery.
+/// Writes the same "(x, y, z)" representation as print.
+/// Returns the number of characters written, 0 if the buffer was
+/// too small. Far cheaper than the ostream path, intended for
+/// logging and serialization hot paths.
+template<size_t D, typename T>
+size_t format(span<char> buf, const Vec<D, T>& vec) {
+	auto rest = buf;
+	auto ok = true;
+	detail::formatAppend(rest, std::string_view("("), ok);
+	for(auto i = 0u; i < D; ++i) {
+		if(i != 0) {
+			detail::formatAppend(rest, std::string_view(", "), ok);
+		}
+
+		detail::formatAppend(rest, vec[i], ok);
+	}
+
+	detail::formatAppend(rest, std::string_view(")"), ok);
+	return ok ? buf.size() - rest.size() : 0;
+}
+
 // - dimension specific -
 /// Calculates the cross product for two 3-dimensional vectors.
 template<typename T1, typename T2>
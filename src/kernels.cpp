@@ -0,0 +1,102 @@
+// Copyright (c) 2017-2020 nyorain
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt
+
+// Out-of-line definitions of the nytl::kernels loops, see nytl/kernels.hpp.
+// Each function is multi-versioned: the compiler emits one clone per
+// listed instruction set plus a baseline and installs an ifunc resolver
+// that picks the best one for the running CPU at load time. On targets
+// without multi-versioning support the baseline is all there is.
+
+#ifndef NYTL_KERNELS
+	#define NYTL_KERNELS
+#endif
+
+#include <nytl/kernels.hpp>
+#include <cmath>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+	#define NYTL_KERNEL __attribute__((target_clones( \
+		"default", "avx2", "arch=x86-64-v4")))
+#else
+	#define NYTL_KERNEL
+#endif
+
+namespace nytl {
+namespace kernels {
+
+NYTL_KERNEL
+void mulSpan(const float* a, const float* b, float* out, std::size_t count) {
+	for(auto i = std::size_t(0); i < count; ++i) {
+		out[i] = a[i] * b[i];
+	}
+}
+
+NYTL_KERNEL
+void fmaddSpan(const float* a, const float* b, float* out, std::size_t count) {
+	for(auto i = std::size_t(0); i < count; ++i) {
+		out[i] += a[i] * b[i];
+	}
+}
+
+NYTL_KERNEL
+void sqrtSpan(float* values, std::size_t count) {
+	for(auto i = std::size_t(0); i < count; ++i) {
+		values[i] = std::sqrt(values[i]);
+	}
+}
+
+NYTL_KERNEL
+void transform4(const float* mat, const float* src, float* dst,
+		std::size_t count) {
+	for(auto i = std::size_t(0); i < count; ++i) {
+		auto* v = src + 4 * i;
+		auto* o = dst + 4 * i;
+		for(auto r = 0u; r < 4; ++r) {
+			o[r] = mat[4 * r + 0] * v[0] + mat[4 * r + 1] * v[1]
+				+ mat[4 * r + 2] * v[2] + mat[4 * r + 3] * v[3];
+		}
+	}
+}
+
+NYTL_KERNEL
+void byteswap2(std::uint16_t* values, std::size_t count) {
+	for(auto i = std::size_t(0); i < count; ++i) {
+		values[i] = std::uint16_t(values[i] << 8 | values[i] >> 8);
+	}
+}
+
+NYTL_KERNEL
+void byteswap4(std::uint32_t* values, std::size_t count) {
+	for(auto i = std::size_t(0); i < count; ++i) {
+		auto v = values[i];
+		values[i] = (v << 24) | ((v & 0xff00u) << 8)
+			| ((v >> 8) & 0xff00u) | (v >> 24);
+	}
+}
+
+NYTL_KERNEL
+void byteswap8(std::uint64_t* values, std::size_t count) {
+	for(auto i = std::size_t(0); i < count; ++i) {
+		auto v = values[i];
+		v = (v >> 32) | (v << 32);
+		v = ((v & 0xffff0000ffff0000u) >> 16)
+			| ((v & 0x0000ffff0000ffffu) << 16);
+		v = ((v & 0xff00ff00ff00ff00u) >> 8)
+			| ((v & 0x00ff00ff00ff00ffu) << 8);
+		values[i] = v;
+	}
+}
+
+NYTL_KERNEL
+std::size_t charCount8(const char* data, std::size_t size) {
+	auto count = std::size_t(0);
+	for(auto i = std::size_t(0); i < size; ++i) {
+		count += (std::uint8_t(data[i]) & 0xc0u) != 0x80u;
+	}
+
+	return count;
+}
+
+} // namespace kernels
+} // namespace nytl